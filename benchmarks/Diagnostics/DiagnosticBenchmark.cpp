@@ -0,0 +1,36 @@
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "Diagnostics/DiagnosticEngine.hpp"
+
+#include "Lexer/LexerBenchmark.hpp"
+
+namespace {
+    // Every line reports several errors, the shape of a malformed machine-generated input
+    constexpr std::string_view kErrorFloodSnippet =
+        "let a = 12abc @ 0b102 $ \"bad \\q escape\" '' 1__0 `\n"
+        "let b = 0x \\ 1.2.3 '\\xZZ' \"\\u{110000}\" 1e # 0o9\n";
+}
+
+// Lexes `kErrorFloodSnippet` repeated to state.range(0) bytes into a fresh DiagnosticEngine,
+// so the cost of recording diagnostics is measured along with the lex
+static void BM_ErrorFlood(benchmark::State& state) {
+    BenchSourceManager sourceManager;
+    ISourceManager::FileID fileID = sourceManager.addBuffer(bench::repeatToSize(kErrorFloodSnippet, state.range(0)));
+    const size_t bytes = sourceManager.getBuffer(fileID).size();
+
+    size_t tokenCount = 0;
+    size_t diagnosticCount = 0;
+    for (auto _ : state) {
+        DiagnosticEngine diagnosticEngine(sourceManager);
+        Lexer lexer(fileID, sourceManager, diagnosticEngine);
+        tokenCount += lexer.tokenize().size();
+        diagnosticCount += diagnosticEngine.getDiagnosticCount();
+    }
+
+    bench::reportThroughput(state, bytes, tokenCount);
+    state.counters["diagnostics"] = benchmark::Counter(static_cast<double>(diagnosticCount), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ErrorFlood)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
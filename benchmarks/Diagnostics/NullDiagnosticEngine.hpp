@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Diagnostics/DiagnosticEngine.hpp"
+#include "Diagnostics/Diagnostic.hpp"
+
+// Discards every diagnostic so benchmarks measure only the phase under test
+class NullDiagnosticEngine : public IDiagnosticEngine {
+public:
+    void addDiagnostic(const Diagnostic&) override {}
+};
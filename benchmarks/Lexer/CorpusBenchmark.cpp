@@ -0,0 +1,43 @@
+#include <string>
+#include <optional>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/Token.hpp"
+#include "SourceManager/SourceManager.hpp"
+
+#include "Lexer/LexerBenchmark.hpp"
+#include "Diagnostics/NullDiagnosticEngine.hpp"
+
+// End to end over the files in benchmarks/corpora: load through the real SourceManager,
+// tokenize, and resolve the position of the last token like a diagnostic would
+static void BM_Corpus(benchmark::State& state, std::string_view name) {
+    const std::string path = std::string(BLAZE_BENCH_CORPUS_DIR) + "/" + std::string(name);
+
+    size_t bytes = 0;
+    size_t tokenCount = 0;
+    for (auto _ : state) {
+        SourceManager sourceManager;
+        NullDiagnosticEngine diagnosticEngine;
+        std::optional<ISourceManager::FileID> fileID = sourceManager.loadFile(path);
+        if (!fileID.has_value()) {
+            state.SkipWithError("Failed to load corpus file");
+            return;
+        }
+
+        Lexer lexer(fileID.value(), sourceManager, diagnosticEngine);
+        std::vector<Token>& tokens = lexer.tokenize();
+        benchmark::DoNotOptimize(sourceManager.getLineTable(fileID.value()).getLineColumn(tokens.back().offset));
+
+        bytes = sourceManager.getBuffer(fileID.value()).size();
+        tokenCount += tokens.size();
+    }
+
+    bench::reportThroughput(state, bytes, tokenCount);
+}
+
+BENCHMARK_CAPTURE(BM_Corpus, Allocator, "allocator.bz");
+BENCHMARK_CAPTURE(BM_Corpus, Geometry, "geometry.bz");
+BENCHMARK_CAPTURE(BM_Corpus, I18n, "i18n.bz");
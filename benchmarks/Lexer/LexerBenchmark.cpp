@@ -0,0 +1,67 @@
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/ParallelLexer.hpp"
+#include "Lexer/Token.hpp"
+
+#include "Lexer/LexerBenchmark.hpp"
+#include "SourceManager/BenchSourceManager.hpp"
+#include "Diagnostics/NullDiagnosticEngine.hpp"
+
+namespace {
+    constexpr std::string_view kAsciiSnippet =
+        "/// Computes the checksum of a block\n"
+        "fn checksum(data: u8, len: u64) -> u32 {\n"
+        "    let mut_hash: u32 = 0x811c_9dc5;\n"
+        "    for index in 0 {\n"
+        "        mut_hash ^= data;\n"
+        "        mut_hash *= 16_777_619;\n"
+        "        if mut_hash >= 1_000_000 && len != 0 { break; }\n"
+        "    }\n"
+        "    /* nested /* block */ comment */\n"
+        "    let label: string = \"checksum\\tdone\\n\";\n"
+        "    return mut_hash << 2;\n"
+        "}\n";
+}
+
+static void BM_TokenizeAscii(benchmark::State& state) {
+    bench::tokenizeSource(state, kAsciiSnippet);
+}
+BENCHMARK(BM_TokenizeAscii)->Arg(64 << 10)->Arg(1 << 20);
+
+// Pull tokens one at a time, token storage stays O(lookahead) instead of O(file)
+static void BM_StreamAscii(benchmark::State& state) {
+    BenchSourceManager sourceManager;
+    NullDiagnosticEngine diagnosticEngine;
+    ISourceManager::FileID fileID = sourceManager.addBuffer(bench::repeatToSize(kAsciiSnippet, state.range(0)));
+    const size_t bytes = sourceManager.getBuffer(fileID).size();
+
+    size_t tokenCount = 0;
+    for (auto _ : state) {
+        Lexer lexer(fileID, sourceManager, diagnosticEngine);
+        for (Token token = lexer.next(); token.kind != TOK_EOF; token = lexer.next()) {
+            benchmark::DoNotOptimize(token);
+            tokenCount += 1;
+        }
+    }
+
+    bench::reportThroughput(state, bytes, tokenCount);
+}
+BENCHMARK(BM_StreamAscii)->Arg(64 << 10)->Arg(1 << 20);
+
+static void BM_ParallelTokenizeAscii(benchmark::State& state) {
+    BenchSourceManager sourceManager;
+    NullDiagnosticEngine diagnosticEngine;
+    ISourceManager::FileID fileID = sourceManager.addBuffer(bench::repeatToSize(kAsciiSnippet, 16 << 20));
+    const size_t bytes = sourceManager.getBuffer(fileID).size();
+
+    for (auto _ : state) {
+        ParallelLexer lexer(fileID, sourceManager, diagnosticEngine, state.range(0));
+        benchmark::DoNotOptimize(lexer.tokenize().data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_ParallelTokenizeAscii)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
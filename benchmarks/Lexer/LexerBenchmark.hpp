@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/Token.hpp"
+
+#include "SourceManager/BenchSourceManager.hpp"
+#include "Diagnostics/NullDiagnosticEngine.hpp"
+
+namespace bench {
+    inline std::string repeatToSize(std::string_view snippet, size_t size) {
+        std::string source;
+        source.reserve(size + snippet.size());
+        while (source.size() < size) {
+            source.append(snippet);
+        }
+        return source;
+    }
+
+    // Reports MB/s through bytes processed and tokens/s through the `tokens` counter
+    inline void reportThroughput(benchmark::State& state, size_t bytes, size_t tokenCount) {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+        state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokenCount), benchmark::Counter::kIsRate);
+    }
+
+    // Tokenizes `snippet` repeated to state.range(0) bytes
+    inline void tokenizeSource(benchmark::State& state, std::string_view snippet) {
+        BenchSourceManager sourceManager;
+        NullDiagnosticEngine diagnosticEngine;
+        ISourceManager::FileID fileID = sourceManager.addBuffer(repeatToSize(snippet, state.range(0)));
+        const size_t bytes = sourceManager.getBuffer(fileID).size();
+
+        size_t tokenCount = 0;
+        for (auto _ : state) {
+            Lexer lexer(fileID, sourceManager, diagnosticEngine);
+            std::vector<Token>& tokens = lexer.tokenize();
+            tokenCount += tokens.size();
+            benchmark::DoNotOptimize(tokens.data());
+        }
+
+        reportThroughput(state, bytes, tokenCount);
+    }
+}
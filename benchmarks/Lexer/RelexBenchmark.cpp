@@ -0,0 +1,60 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "CorpusGenerator.hpp"
+
+#include "Lexer/Lexer.hpp"
+#include "SourceManager/SourceManager.hpp"
+#include "Diagnostics/NullDiagnosticEngine.hpp"
+
+namespace {
+    // Roughly 50k lines of generated source, the size of a large hand-written file
+    constexpr size_t EditedFileSize = 2 << 20;
+
+    // The edited file only ever lives in memory
+    ISourceManager::FileID loadEditedFile(SourceManager& sourceManager) {
+        sourceManager.addOverlay("relex.bz", CorpusGenerator({ .size = EditedFileSize }).generate());
+        return sourceManager.loadFile("relex.bz").value();
+    }
+}
+
+// A keystroke in the middle of the file followed by its undo, each applied and relexed
+static void BM_RelexKeystroke(benchmark::State& state) {
+    SourceManager sourceManager;
+    NullDiagnosticEngine diagnosticEngine;
+    const ISourceManager::FileID fileID = loadEditedFile(sourceManager);
+
+    Lexer lexer(fileID, sourceManager, diagnosticEngine);
+    lexer.tokenize();
+    const std::string_view source = sourceManager.getBuffer(fileID);
+    const size_t offset = source.find("let ", source.size() / 2) + 4;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lexer.relex(sourceManager.applyEdit(fileID, { offset, 0 }, "x")));
+        benchmark::DoNotOptimize(lexer.relex(sourceManager.applyEdit(fileID, { offset, 1 }, "")));
+    }
+
+    state.counters["lines"] = static_cast<double>(sourceManager.getLineTable(fileID).getLineCount());
+}
+
+// The same edits with a full lex of the buffer after each, the cost relexing avoids
+static void BM_RelexFullRetokenize(benchmark::State& state) {
+    SourceManager sourceManager;
+    NullDiagnosticEngine diagnosticEngine;
+    const ISourceManager::FileID fileID = loadEditedFile(sourceManager);
+
+    const std::string_view source = sourceManager.getBuffer(fileID);
+    const size_t offset = source.find("let ", source.size() / 2) + 4;
+
+    for (auto _ : state) {
+        sourceManager.applyEdit(fileID, { offset, 0 }, "x");
+        benchmark::DoNotOptimize(Lexer(fileID, sourceManager, diagnosticEngine).tokenize().size());
+        sourceManager.applyEdit(fileID, { offset, 1 }, "");
+        benchmark::DoNotOptimize(Lexer(fileID, sourceManager, diagnosticEngine).tokenize().size());
+    }
+
+}
+
+BENCHMARK(BM_RelexKeystroke)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RelexFullRetokenize)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,25 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "CorpusGenerator.hpp"
+
+#include "Lexer/LexerBenchmark.hpp"
+
+// Scale and stress inputs from the synthetic corpus generator, see tools/CorpusGen
+static void BM_Synthetic(benchmark::State& state, CorpusOptions options) {
+    options.size = static_cast<size_t>(state.range(0));
+    const std::string source = CorpusGenerator(options).generate();
+    bench::tokenizeSource(state, source);
+}
+
+BENCHMARK_CAPTURE(BM_Synthetic, Default, CorpusOptions{})
+    ->Arg(1 << 20)->Arg(16 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Synthetic, HalfUnicode, CorpusOptions{ .unicodeRatio = 0.5 })
+    ->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Synthetic, LiteralHeavy, CorpusOptions{ .identifierDensity = 0.1 })
+    ->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Synthetic, MegabyteString, CorpusOptions{ .hugeStringSize = 8 << 20 })
+    ->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Synthetic, DeepComment, CorpusOptions{ .hugeCommentDepth = 100000 })
+    ->Arg(1 << 20)->Unit(benchmark::kMillisecond);
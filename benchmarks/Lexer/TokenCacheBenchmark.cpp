@@ -0,0 +1,40 @@
+#include <string>
+#include <optional>
+#include <filesystem>
+
+#include <benchmark/benchmark.h>
+
+#include "CorpusGenerator.hpp"
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/TokenCache.hpp"
+#include "Utils/Hash.hpp"
+#include "SourceManager/BenchSourceManager.hpp"
+#include "Diagnostics/NullDiagnosticEngine.hpp"
+
+// A warm run: load a stored stream and touch every token, against BM_Synthetic for the cold lex
+static void BM_TokenCacheHit(benchmark::State& state) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "blaze_bench_token_cache";
+    BenchSourceManager sourceManager;
+    NullDiagnosticEngine diagnosticEngine;
+    const ISourceManager::FileID fileID = sourceManager.addBuffer(CorpusGenerator({ .size = static_cast<size_t>(state.range(0)) }).generate());
+    const std::string_view source = sourceManager.getBuffer(fileID);
+
+    const TokenCache cache(directory);
+    Lexer lexer(fileID, sourceManager, diagnosticEngine);
+    cache.store(sourceManager.getContentHash(fileID), source, lexer.tokenize(), lexer.getSpellings());
+
+    for (auto _ : state) {
+        std::optional<CachedTokens> cached = cache.load(sourceManager.getContentHash(fileID), source);
+        size_t lexemeBytes = 0;
+        for (const Token& token : cached->tokenize()) {
+            lexemeBytes += cached->getLexeme(token).size();
+        }
+        benchmark::DoNotOptimize(lexemeBytes);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+    std::filesystem::remove_all(directory);
+}
+
+BENCHMARK(BM_TokenCacheHit)->Arg(1 << 20)->Arg(16 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,64 @@
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "Lexer/KeywordTable.hpp"
+
+#include "Lexer/LexerBenchmark.hpp"
+
+// One benchmark per token class, each input is dominated by that class so a regression
+// in a single lexing routine shows up in isolation
+namespace {
+    constexpr std::string_view kIdentifierSnippet =
+        "alpha beta_gamma delta42 epsilon_zeta_eta theta iota kappa_lambda mu nu\n"
+        "xi_omicron pi rho sigma_tau upsilon phi chi psi omega _private __dunder__\n"
+        "camelCaseName PascalCaseName SCREAMING_CASE_NAME a b c x1 y2 z3\n";
+
+    constexpr std::string_view kNumberSnippet =
+        "0 1 123 9876543210 3.14 0.5 123.456 1e10 1.5e-10 1_000_000\n"
+        "0xDEADBEEF 0xaBcDeF 0b101010 0b1010_1010 0o7654321 0o123_456_7\n"
+        "3.1_4 1_000.0_001 1.5_5e10 18446744073709551615 1e308\n";
+
+    constexpr std::string_view kStringSnippet =
+        "\"plain text without escapes\" \"tab\\tseparated\\tvalues\\n\"\n"
+        "\"she said \\\"hello\\\" and left\" \"C:\\\\path\\\\to\\\\file\" \"\"\n"
+        "\"a fairly long string literal that runs for a while before it ends\"\n";
+
+    constexpr std::string_view kBlockCommentSnippet =
+        "/* level one /* level two /* level three */ back to two */ back to one */\n"
+        "/*\n"
+        " * Multi-line banner comment with /* a nested */ aside\n"
+        " */\n";
+
+    constexpr std::string_view kOperatorSnippet =
+        "a=b+c*d-e/f%g;h<<=i>>j;k>>=l<<m;n&&o||!p;q!=r==s;t<=u>=v;w->x;\n"
+        "y+=z-=a*=b/=c%=d&=e|=f^=g;h++;i--;(j&k)|(l^~m)?[n]:{o},p.q;\n";
+
+    constexpr std::string_view kUnicodeIdentifierSnippet =
+        "größe länge fläche straße 名前 変数 値 переменная значение\n"
+        "αβγ δύναμη λόγος ﬁle ﬂow ｌｅｔｔｅｒ ñandú café résumé\n";
+
+    // Every keyword, separated by a space, in declaration order
+    std::string keywordSnippet() {
+        std::string snippet;
+        for (const keywords::Keyword& keyword : keywords::g_keywords) {
+            snippet.append(keyword.spelling);
+            snippet.push_back(' ');
+        }
+        snippet.push_back('\n');
+        return snippet;
+    }
+}
+
+static void BM_TokenClass(benchmark::State& state, std::string_view snippet) {
+    bench::tokenizeSource(state, snippet);
+}
+
+BENCHMARK_CAPTURE(BM_TokenClass, Identifiers, kIdentifierSnippet)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_TokenClass, Keywords, keywordSnippet())->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_TokenClass, Numbers, kNumberSnippet)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_TokenClass, StringsWithEscapes, kStringSnippet)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_TokenClass, NestedBlockComments, kBlockCommentSnippet)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_TokenClass, Operators, kOperatorSnippet)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_TokenClass, UnicodeIdentifiers, kUnicodeIdentifierSnippet)->Arg(1 << 20);
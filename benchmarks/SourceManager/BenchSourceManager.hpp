@@ -0,0 +1,46 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "SourceManager/SourceBuffer.hpp"
+#include "SourceManager/SourceManager.hpp"
+#include "Utils/Hash.hpp"
+
+// Minimal in-memory source manager so benchmarks never touch the disk
+class BenchSourceManager : public ISourceManager {
+public:
+    ISourceManager::FileID addBuffer(std::string source) {
+        // Same padded storage SourceManager hands out
+        m_sources.push_back(SourceBuffer::fromBytes(source));
+        m_lineTables.emplace_back(m_sources.back().view());
+        m_hashes.push_back(hash::hashBytes(m_sources.back().view()));
+        return static_cast<ISourceManager::FileID>(m_sources.size() - 1);
+    }
+
+    std::optional<ISourceManager::FileID> loadFile(const std::string_view) override {
+        return std::nullopt;
+    }
+
+    std::string_view getBuffer(ISourceManager::FileID fileID) const override {
+        return m_sources.at(fileID).view();
+    }
+
+    std::string_view getPath(ISourceManager::FileID) const override {
+        return "<bench>";
+    }
+
+    const LineTable& getLineTable(ISourceManager::FileID fileID) const override {
+        return m_lineTables.at(fileID);
+    }
+
+    ContentHash getContentHash(ISourceManager::FileID fileID) const override {
+        return m_hashes.at(fileID);
+    }
+
+private:
+    std::deque<SourceBuffer> m_sources;
+    std::deque<LineTable> m_lineTables;
+    std::vector<ContentHash> m_hashes;
+};
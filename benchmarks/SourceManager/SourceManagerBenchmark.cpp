@@ -0,0 +1,78 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <filesystem>
+
+#include <benchmark/benchmark.h>
+
+#include "CorpusGenerator.hpp"
+#include "SourceManager/PathCache.hpp"
+#include "SourceManager/SourceBuffer.hpp"
+#include "SourceManager/SourceManager.hpp"
+
+// Load a generated file of state.range(0) bytes through SourceManager::loadFile
+static void BM_LoadFile(benchmark::State& state, SourceBuffer::Mode mode) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "blaze_bench_load.bz";
+    const std::string corpus = CorpusGenerator({ .size = static_cast<size_t>(state.range(0)) }).generate();
+    std::ofstream(path, std::ios::binary) << corpus;
+
+    for (auto _ : state) {
+        SourceManager sourceManager(mode);
+        std::optional<ISourceManager::FileID> fileID = sourceManager.loadFile(path.string());
+        benchmark::DoNotOptimize(sourceManager.getBuffer(fileID.value()).data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus.size()));
+    std::filesystem::remove(path);
+}
+
+BENCHMARK_CAPTURE(BM_LoadFile, Mapped, SourceBuffer::Mode::Mapped)->Arg(64 << 10)->Arg(64 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadFile, Read, SourceBuffer::Mode::Read)->Arg(64 << 10)->Arg(64 << 20)->Unit(benchmark::kMillisecond);
+
+namespace {
+    // A project-shaped directory of small generated modules, written once per process
+    const std::vector<std::string>& moduleTree() {
+        static const std::vector<std::string> paths = [] {
+            const std::filesystem::path directory = std::filesystem::temp_directory_path() / "blaze_bench_modules";
+            std::filesystem::create_directories(directory);
+
+            std::vector<std::string> result;
+            for (uint64_t i = 0; i < 2000; ++i) {
+                const std::filesystem::path path = directory / ("module" + std::to_string(i) + ".bz");
+                std::ofstream(path, std::ios::binary) << CorpusGenerator({ .seed = i, .size = 8 * 1024 }).generate();
+                result.push_back(path.string());
+            }
+            return result;
+        }();
+        return paths;
+    }
+}
+
+// With a shared PathCache every iteration after the first is a warm rebuild in a long-lived process
+static void BM_LoadFilesSerial(benchmark::State& state, bool sharePathCache) {
+    const std::vector<std::string>& paths = moduleTree();
+    std::shared_ptr<PathCache> pathCache = sharePathCache ? std::make_shared<PathCache>() : nullptr;
+    for (auto _ : state) {
+        SourceManager sourceManager(SourceBuffer::Mode::Read, false, pathCache);
+        for (const std::string& path : paths) {
+            benchmark::DoNotOptimize(sourceManager.loadFile(path));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * paths.size()));
+}
+BENCHMARK_CAPTURE(BM_LoadFilesSerial, ColdPathCache, false)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_LoadFilesSerial, SharedPathCache, true)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_LoadFilesBatch(benchmark::State& state, bool useIoUring) {
+    const std::vector<std::string>& paths = moduleTree();
+    for (auto _ : state) {
+        SourceManager sourceManager(SourceBuffer::Mode::Read);
+        benchmark::DoNotOptimize(sourceManager.loadFiles(paths, { .threadCount = static_cast<size_t>(state.range(0)), .useIoUring = useIoUring }));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * paths.size()));
+}
+BENCHMARK_CAPTURE(BM_LoadFilesBatch, ThreadPool, false)->RangeMultiplier(4)->Range(1, 16)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_LoadFilesBatch, IoUring, true)->RangeMultiplier(4)->Range(1, 16)->Unit(benchmark::kMillisecond)->UseRealTime();
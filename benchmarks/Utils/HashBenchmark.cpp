@@ -0,0 +1,15 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "CorpusGenerator.hpp"
+#include "Utils/Hash.hpp"
+
+static void BM_HashBytes(benchmark::State& state) {
+    const std::string bytes = CorpusGenerator({ .size = static_cast<size_t>(state.range(0)) }).generate();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hash::hashBytes(bytes));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_HashBytes)->Arg(4 << 10)->Arg(1 << 20)->Arg(64 << 20);
@@ -1,18 +1,50 @@
 #pragma once
 
+#include <array>
+#include <string>
+#include <cstdint>
+#include <string_view>
+
 #include "Diagnostics/DiagnosticID.hpp"
 #include "SourceManager/SourceManager.hpp"
+#include "Utils/Arena.hpp"
 
+// Byte offset into a file, line and column come from `ISourceManager::getLineTable`
 struct Span {
     SourceManager::FileID fileID;
-    size_t line;
-    size_t column;
+    size_t offset;
+};
+
+// One typed value for a placeholder of the message format, see `DiagnosticInfo::format`
+struct DiagnosticArgument {
+    enum class Kind : uint8_t {
+        String,
+        Codepoint,
+    };
+
+    Kind kind = Kind::String;
+    char32_t codepoint = 0;
+    std::string_view string;
 };
 
+/// Plain value, cheap to copy and store contiguously. Only the ID and the arguments are
+/// recorded, the message is formatted by `formatMessage` when something prints or exports
+/// it, so diagnostics that are dropped or never shown cost no formatting. String arguments
+/// are owned by an arena of whichever engine holds the diagnostic; a diagnostic handed to
+/// `IDiagnosticEngine::addDiagnostic` only has to stay valid for the call.
 struct Diagnostic {
+    static constexpr size_t MaxArguments = 2;
+
     DiagnosticID id;
-    std::string code;
+    const char* code;
     DiagnosticLevel level;
-    std::string message;
     Span span;
+    uint8_t argumentCount = 0;
+    std::array<DiagnosticArgument, MaxArguments> arguments = {};
 };
+
+// Substitutes the arguments into the format of the diagnostic's ID
+std::string formatMessage(const Diagnostic& diagnostic);
+
+// Copies the string arguments into `arena`, so the diagnostic no longer references the reporter's memory
+void copyArguments(Diagnostic& diagnostic, Arena& arena);
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include "Diagnostics/Diagnostic.hpp"
+#include "Diagnostics/DiagnosticEngine.hpp"
+#include "Utils/Arena.hpp"
+
+// Collects diagnostics without reporting them, so speculative work can be committed in order or dropped
+class DiagnosticBuffer : public IDiagnosticEngine {
+public:
+    ~DiagnosticBuffer() override = default;
+
+    void addDiagnostic(const Diagnostic& diagnostic) override;
+
+    // Aborts once the buffered errors alone reach `errorLimit`, the engine flushed into would too
+    void setErrorLimit(size_t errorLimit) { m_errorLimit = errorLimit; }
+    bool shouldAbort() const override { return m_errorLimit != NoErrorLimit && m_errorCount >= m_errorLimit; }
+    size_t getErrorLimit() const override { return m_errorLimit; }
+
+    const std::vector<Diagnostic>& getDiagnostics() const { return m_diagnostics; }
+
+    // Copies every buffered diagnostic into `engine` in the order they were added, then clears
+    void flush(IDiagnosticEngine& engine);
+
+    // Drops every buffered diagnostic along with its arguments
+    void clear();
+
+private:
+    std::vector<Diagnostic> m_diagnostics;
+    Arena m_arguments;
+    size_t m_errorLimit = NoErrorLimit;
+    size_t m_errorCount = 0;
+};
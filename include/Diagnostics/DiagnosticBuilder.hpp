@@ -1,18 +1,25 @@
 #pragma once
 
-#include <memory>
+#include <string_view>
 
 #include "Diagnostics/Diagnostic.hpp"
 
+// Fills in the level and code of `id`, string arguments are referenced, not copied
 class DiagnosticBuilder {
 public:
-    DiagnosticBuilder(DiagnosticID id, std::string message);
+    explicit DiagnosticBuilder(DiagnosticID id);
     ~DiagnosticBuilder() = default;
 
     DiagnosticBuilder& span(Span span);
 
-    std::unique_ptr<Diagnostic> build();
+    // Arguments fill the placeholders of the format in order, at most Diagnostic::MaxArguments
+    DiagnosticBuilder& argument(std::string_view string);
+    DiagnosticBuilder& argument(char32_t codepoint);
+
+    Diagnostic build() const;
 
 private:
-    std::unique_ptr<Diagnostic> m_diagnostic;
+    Diagnostic m_diagnostic;
+
+    DiagnosticArgument& nextArgument();
 };
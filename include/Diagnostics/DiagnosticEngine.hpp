@@ -1,33 +1,101 @@
 #pragma once
 
+#include <span>
+#include <mutex>
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
 
 #include <fmt/format.h>
 
 #include "Diagnostics/Diagnostic.hpp"
 #include "SourceManager/SourceManager.hpp"
+#include "Utils/Arena.hpp"
 
 class IDiagnosticEngine {
 public:
+    static constexpr size_t NoErrorLimit = 0;
+
     virtual ~IDiagnosticEngine() = default;
 
-    virtual void addDiagnostic(std::unique_ptr<Diagnostic> diagnostic) = 0;
+    // Engines copy what they keep, string arguments only have to outlive the call
+    virtual void addDiagnostic(const Diagnostic& diagnostic) = 0;
+
+    // Set once the error limit is reached, reporters should stop and skip their remaining work
+    virtual bool shouldAbort() const { return false; }
+
+    // Errors accepted before `shouldAbort` is set, lets workers buffering diagnostics stop early too
+    virtual size_t getErrorLimit() const { return NoErrorLimit; }
 };
 
+/// Collects diagnostics from any number of threads.
+///
+/// Every reporting thread appends to a shard of its own, found through a thread-local cache,
+/// so `addDiagnostic` takes no lock after a thread's first report. The counters are atomics.
+/// `getDiagnostics` and `printDiagnostics` merge the shards sorted by file and offset, so a
+/// parallel run reports exactly what a sequential one does; they must not run concurrently
+/// with `addDiagnostic`.
+///
+/// With an error limit, the error that reaches it sets `shouldAbort` and everything reported
+/// afterwards is dropped. A fatal `TooManyErrors` diagnostic then ends the merged list.
 class DiagnosticEngine : public IDiagnosticEngine {
 public:
-    DiagnosticEngine(ISourceManager& sourceManager);
+    DiagnosticEngine(ISourceManager& sourceManager, size_t errorLimit = NoErrorLimit);
     ~DiagnosticEngine() {};
 
-    bool hasErrors() const { return m_errorCount > 0; }
+    bool hasErrors() const { return getErrorCount() > 0; }
+    size_t getErrorCount() const { return m_errorCount.load(std::memory_order_relaxed); }
+    size_t getWarningCount() const { return m_warningCount.load(std::memory_order_relaxed); }
+    size_t getDiagnosticCount() const { return m_diagnosticCount.load(std::memory_order_relaxed); }
+
+    void addDiagnostic(const Diagnostic& diagnostic) override;
+
+    bool shouldAbort() const override { return m_aborted.load(std::memory_order_acquire); }
+    size_t getErrorLimit() const override { return m_errorLimit; }
+
+    // Every diagnostic sorted by (FileID, offset), valid until the next `addDiagnostic`
+    std::span<const Diagnostic> getDiagnostics();
 
-    void addDiagnostic(std::unique_ptr<Diagnostic> diagnostic) override;
+    // Diagnostics reported since the previous call, sorted by (FileID, offset) and ended by the
+    // fatal one once it exists. Exporters stream with it, `getDiagnostics` still sees everything
+    std::span<const Diagnostic> getNewDiagnostics();
 
     void printDiagnostics();
 
 private:
+    // Stored by value and back to back, string arguments are bump-allocated in `arguments`
+    struct Shard {
+        std::vector<Diagnostic> diagnostics;
+        Arena arguments;
+    };
+
     ISourceManager& m_sourceManager;
-    size_t m_errorCount = 0;
-    size_t m_warningCount = 0;
-    std::vector<std::unique_ptr<Diagnostic>> m_diagnostics;
+    const uint64_t m_engineID; // Unique per engine, an address could be reused by the next one
+    std::atomic<size_t> m_errorCount = 0;
+    std::atomic<size_t> m_warningCount = 0;
+    std::atomic<size_t> m_diagnosticCount = 0;
+
+    const size_t m_errorLimit;
+    const std::string m_errorLimitText; // Argument of the fatal diagnostic
+    std::atomic<bool> m_aborted = false;
+    std::optional<Diagnostic> m_fatal; // Written once by the thread reaching the limit
+
+    std::mutex m_shardMutex;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::unordered_map<std::thread::id, Shard*> m_threadShards;
+
+    std::vector<Diagnostic> m_merged;
+    size_t m_mergedCount = 0;
+
+    std::vector<Diagnostic> m_newDiagnostics;
+    std::vector<size_t> m_newShardCounts; // Per shard, how many `getNewDiagnostics` returned
+    bool m_hasReturnedFatal = false;
+
+    Shard& getThreadShard();
+    Shard& acquireThreadShard();
 };
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdio>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "Diagnostics/Diagnostic.hpp"
+#include "SourceManager/SourceManager.hpp"
+
+/// Writes diagnostics in a machine-readable format, one at a time as they are handed over.
+///
+/// JSON Lines puts one object per diagnostic on its own line. SARIF 2.1.0 is a single
+/// document whose header is written before the first result and whose closing brackets
+/// `finish` writes. Either way the output is built in a fixed-size buffer flushed to `output`
+/// whenever it fills up or `flush` is called, nothing is kept per diagnostic. Spans are
+/// points, so locations carry the start only: byte offset, 1-based line and codepoint
+/// column. SARIF locations are `file://` URIs, paths that are not absolute such as
+/// `<stdin>` become percent-encoded relative references.
+class DiagnosticExporter {
+public:
+    enum class Format {
+        JsonLines,
+        Sarif,
+    };
+
+    static constexpr size_t BufferSize = 64 * 1024;
+
+    DiagnosticExporter(Format format, const ISourceManager& sourceManager, std::FILE* output);
+    ~DiagnosticExporter();
+
+    DiagnosticExporter(const DiagnosticExporter&) = delete;
+    DiagnosticExporter& operator=(const DiagnosticExporter&) = delete;
+
+    void write(const Diagnostic& diagnostic);
+
+    // Hands everything written so far to `output`, so a consumer sees each file once it is lexed
+    void flush();
+
+    // Completes the document and flushes, later calls do nothing. Called by the destructor
+    void finish();
+
+private:
+    Format m_format;
+    const ISourceManager& m_sourceManager;
+    std::FILE* m_output;
+    fmt::memory_buffer m_buffer;
+    size_t m_resultCount = 0;
+    bool m_isFinished = false;
+
+    void writeJsonLine(const Diagnostic& diagnostic);
+    void writeSarifResult(const Diagnostic& diagnostic);
+    void writeString(std::string_view text);
+    void writeUri(std::string_view path);
+    void writeBuffer();
+};
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <string>
-
 enum class DiagnosticID {
     BlockCommentUnterminated,
 
@@ -48,6 +46,8 @@ enum class DiagnosticID {
     StringEscapeInvalidUnicodeRange,
 
     UnrecognizedSymbol,
+
+    TooManyErrors,
 };
 
 enum class DiagnosticLevel {
@@ -57,59 +57,63 @@ enum class DiagnosticLevel {
     Fatal
 };
 
+// `format` is a fmt format string, its placeholders are filled from `Diagnostic::arguments`
 struct DiagnosticInfo {
     DiagnosticLevel level;
-    std::string code;
+    const char* code;
+    const char* format;
 };
 
 constexpr DiagnosticInfo getDiagnosticInfo(DiagnosticID id) {
     switch (id) {
-        case DiagnosticID::BlockCommentUnterminated: return { DiagnosticLevel::Error, "E1001" };
+        case DiagnosticID::BlockCommentUnterminated: return { DiagnosticLevel::Error, "E1001", "Unterminated {} comment" };
 
         // Number literal errors
-        case DiagnosticID::NumberLiteralInvalidSuffix: return { DiagnosticLevel::Error, "E2001" };
-        case DiagnosticID::NumberLiteralEmptyDigits: return { DiagnosticLevel::Error, "E2002" };
-        case DiagnosticID::NumberLiteralLeadingDot: return { DiagnosticLevel::Error, "E2003" };
-        case DiagnosticID::NumberLiteralMultipleDots: return { DiagnosticLevel::Error, "E2004" };
-        case DiagnosticID::NumberLiteralInvalidDigit: return { DiagnosticLevel::Error, "E2005" };
-        case DiagnosticID::NumberLiteralEmptyExponent: return { DiagnosticLevel::Error, "E2006" };
-        case DiagnosticID::NumberLiteralConsecutiveUnderscore: return { DiagnosticLevel::Error, "E2007" };
-        case DiagnosticID::NumberLiteralLeadingUnderscore: return { DiagnosticLevel::Error, "E2008" };
-        case DiagnosticID::NumberLiteralTrailingUnderscore: return { DiagnosticLevel::Error, "E2009" };
-        case DiagnosticID::NumberLiteralUnderscoreBeforePrefix: return { DiagnosticLevel::Error, "E2010" };
-        case DiagnosticID::NumberLiteralUnderscoreAfterPrefix: return { DiagnosticLevel::Error, "E2011" };
-        case DiagnosticID::NumberLiteralUnderscoreBeforeDot: return { DiagnosticLevel::Error, "E2012" };
+        case DiagnosticID::NumberLiteralInvalidSuffix: return { DiagnosticLevel::Error, "E2001", "Invalid suffix `{}` on number literal" };
+        case DiagnosticID::NumberLiteralEmptyDigits: return { DiagnosticLevel::Error, "E2002", "Numeric literal contains no digits" };
+        case DiagnosticID::NumberLiteralLeadingDot: return { DiagnosticLevel::Error, "E2003", "Floating-point literals must include digits before the decimal point" };
+        case DiagnosticID::NumberLiteralMultipleDots: return { DiagnosticLevel::Error, "E2004", "Numeric literal contains multiple decimal points" };
+        case DiagnosticID::NumberLiteralInvalidDigit: return { DiagnosticLevel::Error, "E2005", "Numeric literal contains invalid digit(s)" };
+        case DiagnosticID::NumberLiteralEmptyExponent: return { DiagnosticLevel::Error, "E2006", "Exponent in numeric literal must contain at least one digit" };
+        case DiagnosticID::NumberLiteralConsecutiveUnderscore: return { DiagnosticLevel::Error, "E2007", "Consecutive underscores are not permitted within numeric literals" };
+        case DiagnosticID::NumberLiteralLeadingUnderscore: return { DiagnosticLevel::Error, "E2008", "Numeric literals cannot start with an underscore" };
+        case DiagnosticID::NumberLiteralTrailingUnderscore: return { DiagnosticLevel::Error, "E2009", "Numeric literals cannot end with an underscore" };
+        case DiagnosticID::NumberLiteralUnderscoreBeforePrefix: return { DiagnosticLevel::Error, "E2010", "Underscores are not allowed before the base prefix in numeric literals" };
+        case DiagnosticID::NumberLiteralUnderscoreAfterPrefix: return { DiagnosticLevel::Error, "E2011", "Underscores are not allowed immediately after the base prefix in numeric literals" };
+        case DiagnosticID::NumberLiteralUnderscoreBeforeDot: return { DiagnosticLevel::Error, "E2012", "Underscores are not allowed immediately before the decimal point in numeric literals" };
 
         // Char literal errors
-        case DiagnosticID::CharEmpty: return { DiagnosticLevel::Error, "E3001" };
-        case DiagnosticID::CharMultiCodepoint: return { DiagnosticLevel::Error, "E3002" };
-        case DiagnosticID::CharUnterminated: return { DiagnosticLevel::Error, "E3003" };
-        case DiagnosticID::CharEscapeUnknown: return { DiagnosticLevel::Error, "E3004" };
-        case DiagnosticID::CharEscapeHexTooShort: return { DiagnosticLevel::Error, "E3005" };
-        case DiagnosticID::CharEscapeInvalidHexDigit: return { DiagnosticLevel::Error, "E3006" };
-        case DiagnosticID::CharEscapeHexOutOfRange: return { DiagnosticLevel::Error, "E3007" };
-        case DiagnosticID::CharEscapeMissingUnicodeBrace: return { DiagnosticLevel::Error, "E3008" };
-        case DiagnosticID::CharEscapeInvalidUnicodeDigit: return { DiagnosticLevel::Error, "E3009" };
-        case DiagnosticID::CharEscapeUnterminatedUnicode: return { DiagnosticLevel::Error, "E3010" };
-        case DiagnosticID::CharEscapeEmptyUnicode: return { DiagnosticLevel::Error, "E3011" };
-        case DiagnosticID::CharEscapeOverlongUnicode: return { DiagnosticLevel::Error, "E3012" };
-        case DiagnosticID::CharEscapeInvalidUnicodeRange: return { DiagnosticLevel::Error, "E3013" };
+        case DiagnosticID::CharEmpty: return { DiagnosticLevel::Error, "E3001", "Character literal cannot be empty" };
+        case DiagnosticID::CharMultiCodepoint: return { DiagnosticLevel::Error, "E3002", "Character literal must contain only one character" };
+        case DiagnosticID::CharUnterminated: return { DiagnosticLevel::Error, "E3003", "Unterminated character literal" };
+        case DiagnosticID::CharEscapeUnknown: return { DiagnosticLevel::Error, "E3004", "unknown character escape: `{}`" };
+        case DiagnosticID::CharEscapeHexTooShort: return { DiagnosticLevel::Error, "E3005", "numeric character escape is too short" };
+        case DiagnosticID::CharEscapeInvalidHexDigit: return { DiagnosticLevel::Error, "E3006", "invalid character in numeric character escape: `{}`" };
+        case DiagnosticID::CharEscapeHexOutOfRange: return { DiagnosticLevel::Error, "E3007", "out of range hex escape" };
+        case DiagnosticID::CharEscapeMissingUnicodeBrace: return { DiagnosticLevel::Error, "E3008", "incorrect unicode escape sequence" };
+        case DiagnosticID::CharEscapeInvalidUnicodeDigit: return { DiagnosticLevel::Error, "E3009", "invalid character in unicode escape: `{}`" };
+        case DiagnosticID::CharEscapeUnterminatedUnicode: return { DiagnosticLevel::Error, "E3010", "unterminated unicode escape" };
+        case DiagnosticID::CharEscapeEmptyUnicode: return { DiagnosticLevel::Error, "E3011", "empty unicode escape" };
+        case DiagnosticID::CharEscapeOverlongUnicode: return { DiagnosticLevel::Error, "E3012", "overlong unicode escape" };
+        case DiagnosticID::CharEscapeInvalidUnicodeRange: return { DiagnosticLevel::Error, "E3013", "invalid unicode character escape" };
 
         // String literal errors
-        case DiagnosticID::StringUnterminated: return { DiagnosticLevel::Error, "E3101" };
-        case DiagnosticID::StringEscapeUnknown: return { DiagnosticLevel::Error, "E3102" };
-        case DiagnosticID::StringEscapeHexTooShort: return { DiagnosticLevel::Error, "E3103" };
-        case DiagnosticID::StringEscapeInvalidHexDigit: return { DiagnosticLevel::Error, "E3104" };
-        case DiagnosticID::StringEscapeHexOutOfRange: return { DiagnosticLevel::Error, "E3105" };
-        case DiagnosticID::StringEscapeMissingUnicodeBrace: return { DiagnosticLevel::Error, "E3106" };
-        case DiagnosticID::StringEscapeInvalidUnicodeDigit: return { DiagnosticLevel::Error, "E3107" };
-        case DiagnosticID::StringEscapeUnterminatedUnicode: return { DiagnosticLevel::Error, "E3108" };
-        case DiagnosticID::StringEscapeEmptyUnicode: return { DiagnosticLevel::Error, "E3109" };
-        case DiagnosticID::StringEscapeOverlongUnicode: return { DiagnosticLevel::Error, "E3110" };
-        case DiagnosticID::StringEscapeInvalidUnicodeRange: return { DiagnosticLevel::Error, "E3111" };
+        case DiagnosticID::StringUnterminated: return { DiagnosticLevel::Error, "E3101", "Unterminated string literal" };
+        case DiagnosticID::StringEscapeUnknown: return { DiagnosticLevel::Error, "E3102", "unknown character escape: `{}`" };
+        case DiagnosticID::StringEscapeHexTooShort: return { DiagnosticLevel::Error, "E3103", "numeric character escape is too short" };
+        case DiagnosticID::StringEscapeInvalidHexDigit: return { DiagnosticLevel::Error, "E3104", "invalid character in numeric character escape: `{}`" };
+        case DiagnosticID::StringEscapeHexOutOfRange: return { DiagnosticLevel::Error, "E3105", "out of range hex escape" };
+        case DiagnosticID::StringEscapeMissingUnicodeBrace: return { DiagnosticLevel::Error, "E3106", "incorrect unicode escape sequence" };
+        case DiagnosticID::StringEscapeInvalidUnicodeDigit: return { DiagnosticLevel::Error, "E3107", "invalid character in unicode escape: `{}`" };
+        case DiagnosticID::StringEscapeUnterminatedUnicode: return { DiagnosticLevel::Error, "E3108", "unterminated unicode escape" };
+        case DiagnosticID::StringEscapeEmptyUnicode: return { DiagnosticLevel::Error, "E3109", "empty unicode escape" };
+        case DiagnosticID::StringEscapeOverlongUnicode: return { DiagnosticLevel::Error, "E3110", "overlong unicode escape" };
+        case DiagnosticID::StringEscapeInvalidUnicodeRange: return { DiagnosticLevel::Error, "E3111", "invalid unicode character escape" };
+
+        case DiagnosticID::UnrecognizedSymbol: return { DiagnosticLevel::Error, "E1010", "Unrecogized symbol `{}`" };
 
-        case DiagnosticID::UnrecognizedSymbol: return { DiagnosticLevel::Error, "E1010" };
+        case DiagnosticID::TooManyErrors: return { DiagnosticLevel::Fatal, "E0001", "Too many errors, stopping after {}" };
 
-        default: return { DiagnosticLevel::Error, "E0000" };
+        default: return { DiagnosticLevel::Error, "E0000", "unknown diagnostic" };
     }
 }
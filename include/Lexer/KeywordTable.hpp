@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "Lexer/Token.hpp"
+
+namespace keywords {
+    struct Keyword {
+        std::string_view spelling;
+        TokenKind kind;
+    };
+
+    inline constexpr std::array<Keyword, 34> g_keywords = {{
+        {"let", TOK_LET},
+        {"const", TOK_CONST},
+        {"fn", TOK_FN},
+        {"return", TOK_RETURN},
+        {"if", TOK_IF},
+        {"elif", TOK_ELIF},
+        {"else", TOK_ELSE},
+        {"while", TOK_WHILE},
+        {"break", TOK_BREAK},
+        {"continue", TOK_CONTINUE},
+        {"for", TOK_FOR},
+        {"true", TOK_TRUE},
+        {"false", TOK_FALSE},
+        {"enum", TOK_ENUM},
+        {"null", TOK_NULL},
+        {"import", TOK_IMPORT},
+        {"export", TOK_EXPORT},
+        {"u8", TOK_U8},
+        {"u16", TOK_U16},
+        {"u32", TOK_U32},
+        {"u64", TOK_U64},
+        {"u128", TOK_U128},
+        {"i8", TOK_I8},
+        {"i16", TOK_I16},
+        {"i32", TOK_I32},
+        {"i64", TOK_I64},
+        {"i128", TOK_I128},
+        {"f16", TOK_F16},
+        {"f32", TOK_F32},
+        {"f64", TOK_F64},
+        {"char", TOK_CHAR},
+        {"string", TOK_STRING},
+        {"bool", TOK_BOOL},
+        {"void", TOK_VOID},
+    }};
+
+    // Every keyword is between 2 and 8 bytes long, anything else can be rejected up front
+    inline constexpr size_t MinKeywordLength = 2;
+    inline constexpr size_t MaxKeywordLength = 8;
+
+    inline constexpr size_t TableSize = 128;
+
+    /// Hashes the length, the first two and the last byte of a candidate keyword.
+    /// Callers must guarantee `MinKeywordLength <= spelling.size()`.
+    constexpr uint32_t hash(std::string_view spelling, uint32_t seed) {
+        uint32_t h = static_cast<uint32_t>(spelling.size());
+        h = h * seed ^ static_cast<uint8_t>(spelling[0]);
+        h = h * seed ^ static_cast<uint8_t>(spelling[1]);
+        h = h * seed ^ static_cast<uint8_t>(spelling.back());
+        return (h ^ (h >> 13)) & (TableSize - 1);
+    }
+
+    constexpr bool isPerfectSeed(uint32_t seed) {
+        std::array<bool, TableSize> used = {};
+        for (const Keyword& keyword : g_keywords) {
+            uint32_t slot = hash(keyword.spelling, seed);
+            if (used[slot]) {
+                return false;
+            }
+            used[slot] = true;
+        }
+        return true;
+    }
+
+    // Searched at compile time, the first seed that maps every keyword to its own slot
+    constexpr uint32_t findPerfectSeed() {
+        uint32_t seed = 1;
+        while (!isPerfectSeed(seed)) {
+            seed += 2;
+        }
+        return seed;
+    }
+
+    inline constexpr uint32_t Seed = findPerfectSeed();
+
+    struct Slot {
+        std::string_view spelling;
+        TokenKind kind = TOK_IDENTIFIER;
+    };
+
+    constexpr std::array<Slot, TableSize> buildTable() {
+        std::array<Slot, TableSize> table = {};
+        for (const Keyword& keyword : g_keywords) {
+            table[hash(keyword.spelling, Seed)] = { keyword.spelling, keyword.kind };
+        }
+        return table;
+    }
+
+    inline constexpr std::array<Slot, TableSize> g_keywordTable = buildTable();
+
+    /// Returns the keyword or primitive type kind for `spelling`, without allocating.
+    constexpr std::optional<TokenKind> lookup(std::string_view spelling) {
+        if (spelling.size() < MinKeywordLength || spelling.size() > MaxKeywordLength) {
+            return std::nullopt;
+        }
+
+        const Slot& slot = g_keywordTable[hash(spelling, Seed)];
+        if (slot.spelling != spelling) {
+            return std::nullopt;
+        }
+        return slot.kind;
+    }
+
+    constexpr bool isRoundTrip() {
+        for (const Keyword& keyword : g_keywords) {
+            if (lookup(keyword.spelling) != keyword.kind) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(isRoundTrip(), "keyword table must resolve every keyword to its own kind");
+}
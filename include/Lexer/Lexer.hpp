@@ -1,12 +1,15 @@
 #pragma once
 
 #include <vector>
+#include <cstdint>
 #include <optional>
 #include <string_view>
 
 #include "Diagnostics/Diagnostic.hpp"
+#include "Diagnostics/DiagnosticBuilder.hpp"
 #include "Diagnostics/DiagnosticID.hpp"
 #include "Lexer/Token.hpp"
+#include "Utils/RingBuffer.hpp"
 #include "SourceManager/SourceManager.hpp"
 #include "Diagnostics/DiagnosticEngine.hpp"
 
@@ -14,8 +17,42 @@ class Lexer {
 public:
     Lexer(ISourceManager::FileID fileID, ISourceManager& sourceManager, IDiagnosticEngine& diagnosticEngine);
 
+    // Lexes only tokens starting in [start, limit), a token crossing `limit` is still lexed to its end
+    Lexer(ISourceManager::FileID fileID, ISourceManager& sourceManager, IDiagnosticEngine& diagnosticEngine, size_t start, size_t limit);
+
+    // Bump whenever the tokens produced for some source change, this invalidates TokenCache entries
+    static constexpr uint32_t Version = 1;
+
+    // Maximum number of tokens `peek` can look ahead
+    static constexpr size_t LookaheadCapacity = 16;
+
+    // Lexes the whole source, convenience wrapper over `next`. Later calls return the same tokens
     std::vector<Token>& tokenize();
 
+    /// Brings the tokens returned by `tokenize` up to date after `edit` went through
+    /// SourceManager::applyEdit. Lexing restarts a couple of tokens before the damage and stops
+    /// at the first new token starting where an old token after the damage started, once
+    /// shifted. From there the old tail is kept and its offsets shifted. Returns the number
+    /// of tokens lexed. Spelling slots of replaced tokens are reused. Diagnostics reported
+    /// for the replaced range stay with the engine, an engine meant to reflect the current
+    /// source has to be cleared and given a fresh lex.
+    size_t relex(const SourceEdit& edit);
+
+    // Consumes and returns the next token, TOK_EOF is returned repeatedly at the end of the source
+    Token next();
+
+    // Returns the token `n` positions ahead without consuming it, `n` must be below `LookaheadCapacity`
+    const Token& peek(size_t n);
+
+    // Returns the lexeme of a token, the normalized spelling for identifiers changed by NFKC
+    std::string_view getLexeme(const Token& token) const;
+
+    // Normalized identifier spellings referenced by `Token::spelling`
+    const std::vector<std::string>& getSpellings() const { return m_spellings; }
+
+    // Offset the next token would start at, once EOF is reached this is where lexing stopped
+    size_t getOffset() const { return m_pos; }
+
 private:
     enum NumericBase {
         Binary = 2,
@@ -32,12 +69,14 @@ private:
 
     size_t m_start = 0;
     size_t m_pos = 0;
-    size_t m_startLine = 1;
-    size_t m_startColumn = 1;
-    size_t m_endLine = 1;
-    size_t m_endColumn = 1;
+    size_t m_limit = SIZE_MAX;
 
     std::vector<Token> m_tokens;
+    RingBuffer<Token, LookaheadCapacity> m_lookahead;
+    bool m_reachedEOF = false;
+    bool m_aborted = false; // The engine hit its error limit, lexing ends at the current token
+    std::vector<std::string> m_spellings;
+    std::vector<uint32_t> m_freeSpellings; // Slots in m_spellings no token references, see `relex`
 
     char32_t advance();
     char32_t peek() const;
@@ -46,9 +85,21 @@ private:
 
     std::string_view getLexeme() const;
 
-    void addToken(TokenKind kind, const std::optional<std::string>& lexeme = std::nullopt);
+    void addToken(TokenKind kind, uint32_t spelling = Token::NoSpelling);
 
-    std::unique_ptr<Diagnostic> buildDiagnostic(DiagnosticID id, std::string message, Span span);
+    // Records the ID and arguments only, the message is formatted if and when it is printed
+    template <typename... Args>
+    Diagnostic buildDiagnostic(DiagnosticID id, Span span, const Args&... arguments) const {
+        DiagnosticBuilder builder(id);
+        builder.span(span);
+        (builder.argument(arguments), ...);
+        return builder.build();
+    }
+
+    void reuseSpellings(size_t first, size_t tail, std::vector<Token>& relexed, size_t spellingBase);
+
+    // Forwards to the engine and stops lexing once it asks reporters to abort
+    void reportDiagnostic(const Diagnostic& diagnostic);
 
     bool isEnd() const;
     bool isWhitespace(char32_t cp) const;
@@ -63,7 +114,8 @@ private:
     bool isIdentifierStart(char32_t cp);
     bool isIdentifierContinue(char32_t cp);
 
-    void skipWhitespace(char32_t cp);
+    void lexToken();
+
     void lexLineComment();
     void lexBlockComment();
     void lexKeywordOrIdentifier();
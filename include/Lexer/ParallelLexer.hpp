@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/Token.hpp"
+#include "SourceManager/SourceManager.hpp"
+#include "Diagnostics/DiagnosticEngine.hpp"
+#include "Diagnostics/DiagnosticBuffer.hpp"
+
+/// Lexes a single large buffer on several threads.
+///
+/// The buffer is split at newlines that a cheap pre-scan believes to be outside
+/// string, char and block comment state. Each chunk is lexed concurrently from its
+/// speculated start offset. While stitching, the offset where chunk N actually
+/// stopped is compared with the start chunk N + 1 assumed, on a mismatch the chunk
+/// is re-lexed from the real offset. Tokens only carry offsets, so the result is
+/// identical to a sequential `Lexer::tokenize`.
+class ParallelLexer {
+public:
+    // Chunks smaller than this are not worth a thread
+    static constexpr size_t DefaultMinChunkSize = 256 * 1024;
+
+    ParallelLexer(
+        ISourceManager::FileID fileID,
+        ISourceManager& sourceManager,
+        IDiagnosticEngine& diagnosticEngine,
+        size_t threadCount,
+        size_t minChunkSize = DefaultMinChunkSize
+    );
+
+    std::vector<Token>& tokenize();
+
+    // Returns the lexeme of a token, the normalized spelling for identifiers changed by NFKC
+    std::string_view getLexeme(const Token& token) const;
+
+    // Normalized identifier spellings referenced by `Token::spelling`
+    const std::vector<std::string>& getSpellings() const { return m_spellings; }
+
+    // Number of chunks whose speculated start cursor was wrong and had to be re-lexed
+    size_t getRelexedChunkCount() const { return m_relexedChunkCount; }
+
+private:
+    struct Chunk {
+        size_t start;
+        size_t end;
+        std::vector<Token> tokens;
+        std::vector<std::string> spellings;
+        DiagnosticBuffer diagnostics;
+        size_t stop;
+    };
+
+    ISourceManager::FileID m_fileID;
+    ISourceManager& m_sourceManager;
+    IDiagnosticEngine& m_diagnosticEngine;
+
+    std::string_view m_source;
+    size_t m_threadCount;
+    size_t m_minChunkSize;
+    size_t m_relexedChunkCount = 0;
+
+    std::vector<Token> m_tokens;
+    std::vector<std::string> m_spellings;
+
+    std::vector<size_t> findBoundaries() const;
+    size_t findSafeBoundary(size_t from, size_t to) const;
+
+    void lexChunk(Chunk& chunk);
+    void appendChunk(Chunk& chunk, bool isLast);
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <string>
+#include <string_view>
+
+#include "Lexer/Token.hpp"
+#include "SourceManager/SourceManager.hpp"
+#include "Diagnostics/DiagnosticEngine.hpp"
+
+/// Lexes a SourceManager stream, see `SourceManager::openStream`, while it is still being read.
+///
+/// Each `lexChunk` reads up to one chunk more from the file descriptor and lexes from the end
+/// of the last committed token. A token ending within `LookaheadMargin` bytes of the input read
+/// so far could still change with the next chunk, an identifier may grow or `<` become `<=`, so
+/// it is dropped along with everything after it, diagnostics included, and lexed again next
+/// time. Once input ends the remainder is lexed to EOF, the result is identical to a
+/// `Lexer::tokenize` over the complete buffer.
+///
+/// Reads and the diagnostics buffered per pass are bounded, the input is not: the stream's
+/// buffer keeps every byte read, since tokens and diagnostics refer to it by offset.
+class StreamingLexer {
+public:
+    static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+    // The lexer decides where a token ends by looking at most 4 codepoints past it
+    static constexpr size_t LookaheadMargin = 16;
+
+    StreamingLexer(
+        SourceManager::FileID fileID,
+        SourceManager& sourceManager,
+        IDiagnosticEngine& diagnosticEngine,
+        int fd,
+        size_t chunkSize = DefaultChunkSize
+    );
+
+    /// Reads and lexes one more chunk and returns the tokens it committed, possibly none. The
+    /// call that sees the end of input returns the rest of the stream including TOK_EOF.
+    std::span<const Token> lexChunk();
+
+    bool isDone() const { return m_isDone; }
+
+    // Reads the remaining input and returns the whole stream
+    std::vector<Token>& tokenize();
+
+    // Returns the lexeme of a token, the normalized spelling for identifiers changed by NFKC
+    std::string_view getLexeme(const Token& token) const;
+
+    // Normalized identifier spellings referenced by `Token::spelling`
+    const std::vector<std::string>& getSpellings() const { return m_spellings; }
+
+private:
+    SourceManager::FileID m_fileID;
+    SourceManager& m_sourceManager;
+    IDiagnosticEngine& m_diagnosticEngine;
+    int m_fd;
+    size_t m_chunkSize;
+    size_t m_readSize;
+
+    size_t m_committed = 0; // Offset where the next pass starts lexing
+    bool m_isDone = false;
+
+    std::vector<Token> m_tokens;
+    std::vector<std::string> m_spellings;
+
+    void lexAvailable(bool isFinal);
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "Lexer/Token.hpp"
+
+namespace symbols {
+    struct Symbol {
+        std::string_view spelling;
+        TokenKind kind;
+    };
+
+    inline constexpr std::array<Symbol, 46> g_symbols = {{
+        {",", TOK_COMMA},
+        {":", TOK_COLON},
+        {";", TOK_SEMICOLON},
+        {".", TOK_DOT},
+        {"~", TOK_BITWISE_NOT},
+        {"(", TOK_LPAREN},
+        {")", TOK_RPAREN},
+        {"{", TOK_LBRACE},
+        {"}", TOK_RBRACE},
+        {"[", TOK_LBRACKET},
+        {"]", TOK_RBRACKET},
+        {"?", TOK_TERNARY_CONDITIONAL},
+        {"=", TOK_ASSIGN},
+        {"+", TOK_PLUS},
+        {"-", TOK_MINUS},
+        {"*", TOK_MULTIPLY},
+        {"/", TOK_DIVIDE},
+        {"%", TOK_MODULO},
+        {"&", TOK_BITWISE_AND},
+        {"|", TOK_BITWISE_OR},
+        {"^", TOK_XOR_ASSIGN},
+        {"<", TOK_LESS_THAN},
+        {">", TOK_GREATER_THAN},
+        {"!", TOK_LOGICAL_NOT},
+        {"!=", TOK_NOT_EQUAL},
+        {"==", TOK_EQUAL},
+        {"->", TOK_ARROW},
+        {"+=", TOK_PLUS_ASSIGN},
+        {"++", TOK_INCREMENT},
+        {"-=", TOK_MINUS_ASSIGN},
+        {"--", TOK_DECREMENT},
+        {"*=", TOK_MULTIPLY_ASSIGN},
+        {"/=", TOK_DIVIDE_ASSIGN},
+        {"%=", TOK_MODULO_ASSIGN},
+        {"&=", TOK_AND_ASSIGN},
+        {"&&", TOK_LOGICAL_AND},
+        {"|=", TOK_OR_ASSIGN},
+        {"||", TOK_LOGICAL_OR},
+        {"^=", TOK_XOR_ASSIGN},
+        {"<=", TOK_LESS_EQUAL},
+        {"<<=", TOK_LEFT_SHIFT_ASSIGN},
+        {"<<", TOK_LEFT_SHIFT},
+        {">=", TOK_GREATER_EQUAL},
+        {">>=", TOK_RIGHT_SHIFT_ASSIGN},
+        {">>", TOK_RIGHT_SHIFT}
+    }};
+
+    // One state per distinct symbol prefix plus the start state
+    inline constexpr size_t MaxStates = 64;
+
+    // All symbols are ASCII, the DFA only needs transitions for the low 128 bytes
+    inline constexpr size_t AlphabetSize = 128;
+
+    inline constexpr uint8_t StartState = 0;
+    inline constexpr uint8_t NoState = 0;
+
+    struct DFA {
+        std::array<std::array<uint8_t, AlphabetSize>, MaxStates> next = {};
+        std::array<TokenKind, MaxStates> accept = {};
+        std::array<bool, MaxStates> accepting = {};
+        size_t stateCount = 1;
+    };
+
+    /// Builds a trie shaped DFA over `g_symbols`. Transitions back to the start
+    /// state are impossible, so `NoState` doubles as the dead state.
+    constexpr DFA buildDFA() {
+        DFA dfa;
+        for (const Symbol& symbol : g_symbols) {
+            uint8_t state = StartState;
+            for (char c : symbol.spelling) {
+                uint8_t& next = dfa.next[state][static_cast<uint8_t>(c)];
+                if (next == NoState) {
+                    next = static_cast<uint8_t>(dfa.stateCount++);
+                }
+                state = next;
+            }
+            dfa.accept[state] = symbol.kind;
+            dfa.accepting[state] = true;
+        }
+        return dfa;
+    }
+
+    inline constexpr DFA g_symbolDFA = buildDFA();
+
+    static_assert(g_symbolDFA.stateCount <= MaxStates, "symbol DFA needs more states");
+
+    // Greedy extension stops at the first byte that does not form a symbol,
+    // which is only maximal munch if every prefix of a symbol is a symbol itself
+    constexpr bool isPrefixClosed() {
+        for (size_t state = 1; state < g_symbolDFA.stateCount; ++state) {
+            if (!g_symbolDFA.accepting[state]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(isPrefixClosed(), "every symbol prefix must be a symbol");
+
+    /// Returns the state reached from `state` on `byte`, or `NoState`.
+    constexpr uint8_t step(uint8_t state, uint8_t byte) {
+        return byte < AlphabetSize ? g_symbolDFA.next[state][byte] : NoState;
+    }
+}
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>
+#include <cstdint>
+#include <string_view>
 
-enum TokenKind {
+enum TokenKind : uint8_t {
     // Keywords
     TOK_LET,                    // "let"
     TOK_CONST,                  // "const"
@@ -115,14 +116,21 @@ enum TokenKind {
     TOK_EOF
 };
 
+/// Compact token referencing its lexeme by byte range in the SourceManager buffer.
+/// Identifiers whose NFKC form differs from the source carry a handle to the
+/// normalized spelling owned by the Lexer, see `Lexer::getLexeme`.
+/// Line and column are resolved on demand through the file's `LineTable`.
+/// The kind shares a 64-bit word with a 56-bit offset, so sources past 4 GiB work while a
+/// token stays 16 bytes. A single token is limited to 4 GiB.
 struct Token {
-    TokenKind kind;
-    std::pair<size_t, size_t> position;
-    std::string lexeme;
-};
-
-extern std::unordered_map<std::string, TokenKind> g_keywordMap;
+    static constexpr uint32_t NoSpelling = UINT32_MAX;
+    static constexpr uint64_t MaxOffset = (uint64_t(1) << 56) - 1;
 
-extern std::unordered_map<std::string, TokenKind> g_symbolMap;
+    TokenKind kind : 8;
+    uint64_t offset : 56;
+    uint32_t length;
+    uint32_t spelling = NoSpelling;
+};
+static_assert(sizeof(Token) <= 16, "Token arrays are the lexer's main memory cost");
 
-std::string TokenKindToString(Token token);
+std::string TokenKindToString(TokenKind kind, std::string_view lexeme);
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <filesystem>
+#include <string_view>
+
+#include "Lexer/Token.hpp"
+#include "Utils/Hash.hpp"
+#include "SourceManager/SourceBuffer.hpp"
+
+/// A token stream read back from a TokenCache entry. The entry stays mapped and tokens
+/// are used in place, so loading costs a page fault per 4 KiB rather than a lex.
+class CachedTokens {
+public:
+    // Same shape as `Lexer::tokenize`, the stream ends with TOK_EOF
+    std::span<const Token> tokenize() const { return m_tokens; }
+
+    // Returns the lexeme of a token, the normalized spelling for identifiers changed by NFKC
+    std::string_view getLexeme(const Token& token) const;
+
+private:
+    friend class TokenCache;
+
+    SourceBuffer m_entry;
+    std::string_view m_source;
+    std::span<const Token> m_tokens;
+    const uint32_t* m_spellingOffsets = nullptr;
+    const char* m_spellings = nullptr;
+};
+
+/// Opt-in directory of lexed token streams, one file per distinct source content.
+///
+/// Entries are named after the ContentHash and `Lexer::Version`, so an edited file or a
+/// lexer whose output changed simply misses. An entry stores the tokens as they sit in
+/// memory followed by the normalized spellings; it is written to a temporary file and
+/// renamed into place, so compiler runs sharing the directory never see a partial entry.
+/// Entries that fail validation are treated as misses.
+class TokenCache {
+public:
+    explicit TokenCache(std::filesystem::path directory);
+
+    std::optional<CachedTokens> load(const ContentHash& hash, std::string_view source) const;
+
+    // Returns false when the entry could not be written, the cache is best effort
+    bool store(const ContentHash& hash, std::string_view source, std::span<const Token> tokens, const std::vector<std::string>& spellings) const;
+
+    std::filesystem::path getEntryPath(const ContentHash& hash) const;
+
+private:
+    std::filesystem::path m_directory;
+};
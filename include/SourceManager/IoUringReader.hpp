@@ -0,0 +1,52 @@
+#pragma once
+
+#include <span>
+#include <cstddef>
+
+/// Batched file reads through a Linux io_uring, driven with raw syscalls so there is no
+/// liburing dependency. Built only when BLAZE_HAS_IO_URING is defined; elsewhere, or when
+/// the kernel or a seccomp policy refuses the ring, `isValid()` is false and callers fall
+/// back to plain reads.
+class IoUringReader {
+public:
+    struct Request {
+        int fd;
+        char* data;
+        size_t size;
+        size_t done = 0;
+        bool failed = false;
+    };
+
+    explicit IoUringReader(unsigned entries = 64);
+    ~IoUringReader();
+
+    IoUringReader(const IoUringReader&) = delete;
+    IoUringReader& operator=(const IoUringReader&) = delete;
+
+    bool isValid() const { return m_ringFd >= 0; }
+
+    /// Reads every request to completion or EOF, with up to `entries` reads in flight.
+    /// Returns false if the ring stopped working, requests may then be partially done.
+    bool readAll(std::span<Request> requests);
+
+private:
+    int m_ringFd = -1;
+    unsigned m_entries = 0;
+
+    void* m_sqRing = nullptr;
+    void* m_cqRing = nullptr;
+    void* m_sqes = nullptr;
+    size_t m_sqRingSize = 0;
+    size_t m_cqRingSize = 0;
+    size_t m_sqesSize = 0;
+
+    unsigned* m_sqTail = nullptr;
+    unsigned* m_sqMask = nullptr;
+    unsigned* m_sqArray = nullptr;
+    unsigned* m_cqHead = nullptr;
+    unsigned* m_cqTail = nullptr;
+    unsigned* m_cqMask = nullptr;
+    void* m_cqes = nullptr;
+
+    void release();
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <string_view>
+
+/// Line start offsets of a source buffer, built once with a vectorized newline scan.
+/// Line and column are resolved lazily by binary search, only when a diagnostic or
+/// a dump needs them. Both are 1-based, columns count codepoints.
+class LineTable {
+public:
+    LineTable() = default;
+    explicit LineTable(std::string_view buffer);
+
+    std::pair<size_t, size_t> getLineColumn(size_t offset) const;
+
+    /// Patches the table after `removedLength` bytes at `offset` were replaced by `insertedLength`
+    /// bytes, `buffer` being the edited contents. Only the inserted bytes are scanned, line starts
+    /// after the edit are shifted.
+    void applyEdit(std::string_view buffer, size_t offset, size_t removedLength, size_t insertedLength);
+
+    size_t getLine(size_t offset) const;
+
+    size_t getLineCount() const { return m_lineStarts.size(); }
+
+    // Byte offset of the first character of a 1-based line
+    size_t getLineStart(size_t line) const { return m_lineStarts[line - 1]; }
+
+private:
+    std::string_view m_buffer;
+    std::vector<uint64_t> m_lineStarts;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+/// Memoizes path canonicalization for SourceManager.
+///
+/// Canonicalizing costs an lstat, and a readlink for symlinks, per path component, and is
+/// repeated for every import of the same module. An entry is reused while a single stat of
+/// the path still finds the same file, by device and inode, with the same modification time;
+/// re-pointing a symlink or replacing the file misses and canonicalizes again. Missing paths
+/// are not cached, checking for them already costs just the one stat.
+///
+/// Thread-safe, so batch loads canonicalize concurrently and several SourceManagers, such as
+/// one per compilation in a long-lived process, can share one cache.
+class PathCache {
+public:
+    // Absolute path without `.`, `..` or symlinks, nullopt if `path` does not exist
+    std::optional<std::string> canonicalize(std::string_view path);
+
+    size_t getHitCount() const { return m_hitCount.load(std::memory_order_relaxed); }
+    size_t getMissCount() const { return m_missCount.load(std::memory_order_relaxed); }
+
+private:
+    struct FileIdentity {
+        uint64_t device = 0;
+        uint64_t inode = 0;
+        int64_t modifiedSeconds = 0;
+        int64_t modifiedNanoseconds = 0;
+
+        bool operator==(const FileIdentity& other) const = default;
+    };
+
+    struct Entry {
+        std::string canonicalPath;
+        FileIdentity identity;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries; // Keyed by the absolute path as given
+    std::atomic<size_t> m_hitCount = 0;
+    std::atomic<size_t> m_missCount = 0;
+
+    static std::optional<FileIdentity> statPath(const std::string& path);
+};
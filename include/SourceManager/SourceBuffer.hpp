@@ -0,0 +1,94 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <optional>
+#include <string_view>
+
+/// Owns the bytes of one source file.
+///
+/// Large files are memory-mapped read-only, so views point straight into the page cache
+/// and nothing is copied. Small files, and platforms without mmap, are read into one
+/// exactly sized heap allocation. Either way the buffer never moves once created, until
+/// it is edited through `replace`.
+///
+/// Every view is followed by at least `Padding` NUL bytes that are part of the allocation
+/// or mapping. Scanners can stop on the NUL sentinel instead of checking the size per byte,
+/// and load whole SIMD blocks across the end of the source.
+class SourceBuffer {
+public:
+    enum class Mode {
+        Auto,     // Map files of at least MapThreshold bytes, read the rest
+        Mapped,   // Always map non-empty files, fall back to reading if mapping fails
+        Read,     // Always read into a heap allocation
+        Windowed, // Map like Mapped, for files too large to keep resident, see `evict`
+    };
+
+    // Below this size a read is cheaper than setting up and tearing down a mapping
+    static constexpr size_t MapThreshold = 64 * 1024;
+
+    // How much of a Windowed buffer is meant to be resident at a time
+    static constexpr size_t WindowSize = 64 * 1024 * 1024;
+
+    // NUL bytes readable past the end of every view, one cache line and a full AVX-512 load
+    static constexpr size_t Padding = 64;
+
+    SourceBuffer() = default;
+    ~SourceBuffer();
+
+    SourceBuffer(SourceBuffer&& other) noexcept;
+    SourceBuffer& operator=(SourceBuffer&& other) noexcept;
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    static std::optional<SourceBuffer> fromFile(const std::string& path, Mode mode = Mode::Auto);
+
+    // Copies `bytes` into an exactly sized heap allocation
+    static SourceBuffer fromBytes(std::string_view bytes);
+
+    /// First half of fromFile, for callers that batch the reads themselves. Mapped and empty
+    /// files come back complete with `fd` set to -1. Otherwise the buffer is allocated but
+    /// unfilled: read `size()` bytes from `fd` into `fillData()`, call `finishFill` with the
+    /// count actually read, then `closeFile(fd)`.
+    static std::optional<SourceBuffer> prepare(const std::string& path, Mode mode, int& fd);
+    char* fillData() { return m_storage.get(); }
+    void finishFill(size_t bytesRead);
+
+    // Positional read loop used by fromFile, returns the number of bytes read
+    static size_t readFully(int fd, char* data, size_t size, size_t offset = 0);
+    static void closeFile(int fd);
+
+    /// Replaces `length` bytes at `offset` with `text`. The first edit copies a mapped buffer
+    /// into a heap allocation with slack, later edits shift the tail in place and only
+    /// reallocate when the slack runs out. Invalidates views taken before the call.
+    void replace(size_t offset, size_t length, std::string_view text);
+
+    /// Reads at most `maxBytes` from `fd` straight onto the end of the buffer, growing it
+    /// geometrically. Returns the number of bytes appended, 0 at end of input, or nullopt if
+    /// the read failed. Invalidates views taken before the call.
+    std::optional<size_t> readAppend(int fd, size_t maxBytes);
+
+    /// Drops the resident pages of a mapped buffer that lie entirely within [begin, end). They
+    /// are read back from the file if touched again, so views stay valid; this only bounds
+    /// memory use while a huge file is walked front to back. Does nothing for heap buffers.
+    void evict(size_t begin, size_t end);
+
+    std::string_view view() const { return std::string_view(m_data, m_size); }
+    size_t size() const { return m_size; }
+    bool isMapped() const { return m_isMapped; }
+
+private:
+    // Backs empty buffers, so even they are followed by the padding
+    alignas(Padding) static constexpr char EmptyPadding[Padding] = {};
+
+    const char* m_data = EmptyPadding;
+    size_t m_size = 0;
+    bool m_isMapped = false;
+    size_t m_mappedSize = 0; // Includes the padding pages
+    size_t m_capacity = 0;   // Of the heap storage, which has Padding more bytes
+    std::unique_ptr<char[]> m_storage;
+
+    void release();
+    void grow(size_t capacity);
+    void terminate();
+};
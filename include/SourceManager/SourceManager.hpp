@@ -1,10 +1,20 @@
 #pragma once
 
+#include <span>
+#include <deque>
+#include <memory>
 #include <string>
 #include <vector>
 #include <optional>
 #include <unordered_map>
 
+#include "SourceManager/LineTable.hpp"
+#include "SourceManager/PathCache.hpp"
+#include "SourceManager/SourceBuffer.hpp"
+#include "Utils/Hash.hpp"
+
+/// Buffers returned by `getBuffer` must be followed by at least SourceBuffer::Padding NUL
+/// bytes, the lexer scans up to a NUL sentinel and reads whole SIMD blocks past the end.
 class ISourceManager {
 public:
     using FileID = int;
@@ -14,22 +24,106 @@ public:
     virtual std::optional<ISourceManager::FileID> loadFile(const std::string_view path) = 0;
     virtual std::string_view getBuffer(ISourceManager::FileID fileID) const = 0;
     virtual std::string_view getPath(ISourceManager::FileID fileID) const = 0;
+    virtual const LineTable& getLineTable(ISourceManager::FileID fileID) const = 0;
+    virtual ContentHash getContentHash(ISourceManager::FileID fileID) const = 0;
+};
+
+struct SourceRange {
+    size_t offset;
+    size_t length;
+};
+
+/// Describes a replacement in terms of the buffer as it was before the edit
+struct SourceEdit {
+    size_t offset;
+    size_t removedLength;
+    size_t insertedLength;
+};
+
+struct BatchLoadOptions {
+    size_t threadCount = 0; // 0 uses one worker per hardware thread
+    bool useIoUring = true; // Only takes effect in builds with BLAZE_HAS_IO_URING
 };
 
 class SourceManager : public ISourceManager {
 public:
+    /// With `shareIdenticalBuffers`, files whose bytes are identical to an already loaded file
+    /// keep their own FileID and path but share its buffer and line table. Path lookups go
+    /// through `pathCache`, pass one in to keep it across SourceManagers, otherwise each gets
+    /// its own.
+    explicit SourceManager(
+        SourceBuffer::Mode bufferMode = SourceBuffer::Mode::Auto,
+        bool shareIdenticalBuffers = false,
+        std::shared_ptr<PathCache> pathCache = nullptr
+    )
+    :   m_bufferMode(bufferMode),
+        m_shareIdenticalBuffers(shareIdenticalBuffers),
+        m_pathCache(pathCache != nullptr ? std::move(pathCache) : std::make_shared<PathCache>()) {}
     ~SourceManager() override;
 
     std::optional<FileID> loadFile(const std::string_view path) override;
+
+    /// Registers `contents` under a virtual path that takes priority over the disk, for unsaved
+    /// editor buffers, generated code and hermetic tests. The path does not have to exist;
+    /// relative paths are resolved against the working directory and `..` is folded, without
+    /// following symlinks. A path already loaded keeps its FileID, the overlay is rejected and
+    /// false returned; edit the loaded file with applyEdit instead.
+    bool addOverlay(std::string_view path, std::string contents);
+
+    /// Loads many files at once. Canonicalization, stat, mapping and reads run concurrently,
+    /// FileIDs are still assigned in the order of `paths`, exactly as calling loadFile on each
+    /// path in turn would. Results line up with `paths`.
+    std::vector<std::optional<FileID>> loadFiles(std::span<const std::string> paths, BatchLoadOptions options = {});
     std::string_view getBuffer(FileID fileID) const override;
     std::string_view getPath(FileID fileID) const override;
+    const LineTable& getLineTable(FileID fileID) const override;
+    ContentHash getContentHash(FileID fileID) const override;
+
+    /// Replaces `range` of a loaded file with `text`, in memory only. The line table is patched
+    /// around the edit and the fingerprint is recomputed lazily. A buffer shared with identical
+    /// files is copied first, the other files keep the original contents.
+    /// Throws std::out_of_range if `range` is not inside the buffer.
+    SourceEdit applyEdit(FileID fileID, SourceRange range, std::string_view text);
+
+    /// Drops the resident pages of a mapped file within [begin, end), see SourceBuffer::evict.
+    /// With SourceBuffer::Mode::Windowed, files are loaded a window at a time and evicted
+    /// behind it, and are not fingerprinted until getContentHash is called, so they are not
+    /// shared either. Calling evict behind the lexer keeps only a window of the file in memory.
+    void evict(FileID fileID, size_t begin, size_t end);
+
+    /// Registers an empty buffer for input that arrives over time, such as a pipe. `name` is
+    /// reported as the path but is neither canonicalized nor looked up by loadFile.
+    FileID openStream(std::string name);
+
+    /// Reads at most `maxBytes` from `fd` onto the end of a stream opened with openStream and
+    /// indexes the new lines. Returns the bytes appended, 0 once input ended, nullopt if the
+    /// read failed. Views of the buffer taken before the call may be invalidated.
+    std::optional<size_t> readStream(FileID fileID, int fd, size_t maxBytes);
 
 private:
+    struct SourceContent {
+        SourceBuffer buffer;
+        LineTable lineTable;
+        mutable std::optional<ContentHash> hash; // Empty after an edit until requested
+        size_t fileCount = 1;
+    };
+
     struct SourceFile {
         std::string path;
-        std::string source;
+        size_t content; // Index into m_contents
     };
 
-    std::vector<SourceFile> m_sources;
+    SourceBuffer::Mode m_bufferMode;
+    bool m_shareIdenticalBuffers;
+    std::shared_ptr<PathCache> m_pathCache;
+
+    // Deques keep every entry in place, buffer views and line tables stay valid as files are added
+    std::deque<SourceContent> m_contents;
+    std::deque<SourceFile> m_sources;
     std::unordered_map<std::string, FileID> m_pathToID;
+    std::unordered_map<ContentHash, size_t, ContentHash::Hasher> m_hashToContent;
+    std::unordered_map<std::string, std::string> m_overlays; // Dropped once loaded
+
+    static std::string getOverlayPath(std::string_view path);
+    FileID addFile(std::string path, SourceBuffer buffer, LineTable lineTable, std::optional<ContentHash> hash);
 };
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/// Bump allocator for data that lives exactly as long as its owner, such as diagnostic messages.
+/// Allocations are carved out of blocks that double in size up to `MaxBlockSize` and are freed
+/// all at once, nothing is destroyed, so only trivially destructible data belongs here.
+/// Addresses stay valid when the arena is moved.
+class Arena {
+public:
+    static constexpr size_t InitialBlockSize = 4 * 1024;
+    static constexpr size_t MaxBlockSize = 1024 * 1024;
+
+    Arena() = default;
+    Arena(Arena&&) noexcept = default;
+    Arena& operator=(Arena&&) noexcept = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        const uintptr_t cursor = reinterpret_cast<uintptr_t>(m_cursor);
+        const uintptr_t aligned = (cursor + alignment - 1) & ~(alignment - 1);
+        if (m_cursor != nullptr && aligned + size <= reinterpret_cast<uintptr_t>(m_end)) [[likely]] {
+            m_cursor = reinterpret_cast<char*>(aligned + size);
+            return reinterpret_cast<void*>(aligned);
+        }
+        return allocateSlow(size, alignment);
+    }
+
+    // Copies `text` into the arena, the view stays valid until the arena is reset or destroyed
+    std::string_view copyString(std::string_view text);
+
+    // Frees every allocation at once
+    void reset();
+
+    // Bytes reserved from the system, for tests and statistics
+    size_t getCapacity() const { return m_capacity; }
+
+private:
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char* m_cursor = nullptr;
+    char* m_end = nullptr;
+    size_t m_nextBlockSize = InitialBlockSize;
+    size_t m_capacity = 0;
+
+    void* allocateSlow(size_t size, size_t alignment);
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+/// 128-bit non-cryptographic content fingerprint.
+/// Stable across runs and platforms of the same endianness, so it can key on-disk caches.
+struct ContentHash {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const ContentHash& other) const = default;
+
+    // 32 lowercase hex digits, high half first
+    std::string toString() const;
+
+    struct Hasher {
+        size_t operator()(const ContentHash& hash) const { return static_cast<size_t>(hash.low); }
+    };
+};
+
+namespace hash {
+    /// Hashes 32-byte stripes with two 64x64->128 bit multiply-fold lanes, several GB/s per core
+    ContentHash hashBytes(std::string_view bytes, uint64_t seed = 0);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+/// Runs body(0) ... body(count - 1) on up to `threadCount` workers, the calling thread included.
+/// Workers pull the next index from a shared counter, so uneven items balance themselves.
+/// A `threadCount` of 0 uses one worker per hardware thread.
+template <typename Body>
+void parallelFor(size_t count, size_t threadCount, const Body& body) {
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threadCount = std::min(threadCount, count);
+
+    std::atomic<size_t> next = 0;
+    auto worker = [&] {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count; i = next.fetch_add(1, std::memory_order_relaxed)) {
+            body(i);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount > 0 ? threadCount - 1 : 0);
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+}
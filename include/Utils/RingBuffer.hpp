@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+/// Fixed capacity FIFO over inline storage, never allocates.
+/// `Capacity` must be a power of two so wrapping is a mask.
+template <typename T, size_t Capacity>
+class RingBuffer {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+public:
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    bool full() const { return m_size == Capacity; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    /// Element `i` counted from the front, `i` must be less than `size()`.
+    T& operator[](size_t i) { return m_items[(m_head + i) & (Capacity - 1)]; }
+    const T& operator[](size_t i) const { return m_items[(m_head + i) & (Capacity - 1)]; }
+
+    T& front() { return (*this)[0]; }
+
+    void push_back(const T& item) {
+        if (full()) {
+            throw std::length_error("RingBuffer is full");
+        }
+        m_items[(m_head + m_size) & (Capacity - 1)] = item;
+        m_size += 1;
+    }
+
+    T pop_front() {
+        T item = front();
+        m_head = (m_head + 1) & (Capacity - 1);
+        m_size -= 1;
+        return item;
+    }
+
+    void clear() {
+        m_head = 0;
+        m_size = 0;
+    }
+
+private:
+    std::array<T, Capacity> m_items = {};
+    size_t m_head = 0;
+    size_t m_size = 0;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace unicode {
+    /// Start / continue bitmaps for 64 consecutive codepoints
+    struct XIDLeaf {
+        uint64_t start;
+        uint64_t cont;
+    };
+
+    // Generated at build time from ICU by tools/GenUnicodeTables.cpp, see src/Utils/Unicode.cpp
+    extern const uint8_t g_xidStage1[];
+    extern const uint16_t g_xidStage2[];
+    extern const XIDLeaf g_xidLeaves[];
+
+    constexpr uint32_t MaxCodepoint = 0x10FFFF;
+
+    enum ASCIIClass : uint8_t {
+        ASCII_XID_START = 1 << 0,
+        ASCII_XID_CONTINUE = 1 << 1,
+    };
+
+    constexpr std::array<uint8_t, 128> g_asciiClass = [] {
+        std::array<uint8_t, 128> table = {};
+        for (char32_t c = 0; c < 128; ++c) {
+            const bool isLetter = (c >= U'a' && c <= U'z') || (c >= U'A' && c <= U'Z');
+            const bool isDigit = c >= U'0' && c <= U'9';
+            table[c] = (isLetter ? ASCII_XID_START : 0) | (isLetter || isDigit || c == U'_' ? ASCII_XID_CONTINUE : 0);
+        }
+        return table;
+    }();
+
+    inline const XIDLeaf& xidLeaf(char32_t cp) {
+        const uint32_t block = g_xidStage1[cp >> 12];
+        return g_xidLeaves[g_xidStage2[(block << 6) | ((cp >> 6) & 63)]];
+    }
+
+    /// Unicode XID_Start, answered from the ASCII bitmap or the generated trie without calling into ICU
+    inline bool isXIDStart(char32_t cp) {
+        if (cp < 128) {
+            return g_asciiClass[cp] & ASCII_XID_START;
+        }
+        if (cp > MaxCodepoint) {
+            return false;
+        }
+        return (xidLeaf(cp).start >> (cp & 63)) & 1;
+    }
+
+    /// Unicode XID_Continue, answered from the ASCII bitmap or the generated trie without calling into ICU
+    inline bool isXIDContinue(char32_t cp) {
+        if (cp < 128) {
+            return g_asciiClass[cp] & ASCII_XID_CONTINUE;
+        }
+        if (cp > MaxCodepoint) {
+            return false;
+        }
+        return (xidLeaf(cp).cont >> (cp & 63)) & 1;
+    }
+}
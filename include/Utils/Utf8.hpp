@@ -1,25 +1,24 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
+#include <algorithm>
+#include <string_view>
+#include <unicode/utf8.h>
 #include <unicode/normalizer2.h>
 
 namespace utf8 {
-    /// Decodes a single UTF-8 codepoint from input[index]
-    /// Returns number of bytes consumed. `cp` is filled with the decoded char32_t.
-    /// If invalid, returns 0 and sets cp to 0xFFFD.
-    inline size_t decodeCodepoint(const std::string_view input, size_t index, char32_t& cp) {
-        if (index >= input.size()) {
-            cp = 0xFFFD;
-            return 0;
-        }
-
-        const uint8_t* s = reinterpret_cast<const uint8_t*>(input.data());
-        int32_t offset = static_cast<int32_t>(index);
-        int32_t length = static_cast<int32_t>(input.size());
+    /// Decodes a multi-byte UTF-8 sequence starting at input[index] through ICU.
+    /// Callers are expected to have handled the ASCII case already.
+    inline size_t decodeMultiByteCodepoint(const std::string_view input, size_t index, char32_t& cp) {
+        // ICU indexes with int32_t, so decode from a pointer to the lead byte rather than the buffer
+        // start. A sequence is at most 4 bytes, which keeps offsets far beyond 2 GiB in range.
+        const uint8_t* s = reinterpret_cast<const uint8_t*>(input.data()) + index;
+        const int32_t length = static_cast<int32_t>(std::min<size_t>(input.size() - index, 4));
+        int32_t offset = 0;
 
         UChar32 codepoint = 0;
 
-        int32_t startOffset = offset;
         U8_NEXT(s, offset, length, codepoint);
 
         if (codepoint < 0) {
@@ -28,7 +27,26 @@ namespace utf8 {
         }
 
         cp = static_cast<char32_t>(codepoint);
-        return static_cast<size_t>(offset - startOffset);
+        return static_cast<size_t>(offset);
+    }
+
+    /// Decodes a single UTF-8 codepoint from input[index]
+    /// Returns number of bytes consumed. `cp` is filled with the decoded char32_t.
+    /// If invalid, returns 0 and sets cp to 0xFFFD.
+    /// ASCII bytes are decoded inline, everything else falls back to ICU.
+    inline size_t decodeCodepoint(const std::string_view input, size_t index, char32_t& cp) {
+        if (index >= input.size()) {
+            cp = 0xFFFD;
+            return 0;
+        }
+
+        const uint8_t lead = static_cast<uint8_t>(input[index]);
+        if (lead < 0x80) [[likely]] {
+            cp = lead;
+            return 1;
+        }
+
+        return decodeMultiByteCodepoint(input, index, cp);
     }
 
     // Encodes a single Unicode codepoint to UTF-8 string
@@ -0,0 +1,31 @@
+#include "Diagnostics/Diagnostic.hpp"
+
+#include <string>
+
+#include <fmt/args.h>
+#include <fmt/format.h>
+
+#include "Diagnostics/DiagnosticID.hpp"
+#include "Utils/Arena.hpp"
+#include "Utils/Utf8.hpp"
+
+std::string formatMessage(const Diagnostic& diagnostic) {
+    fmt::dynamic_format_arg_store<fmt::format_context> arguments;
+    for (size_t i = 0; i < diagnostic.argumentCount; ++i) {
+        const DiagnosticArgument& argument = diagnostic.arguments[i];
+        switch (argument.kind) {
+            case DiagnosticArgument::Kind::String: arguments.push_back(argument.string); break;
+            case DiagnosticArgument::Kind::Codepoint: arguments.push_back(utf8::encodeCodepoint(argument.codepoint)); break;
+        }
+    }
+    return fmt::vformat(getDiagnosticInfo(diagnostic.id).format, arguments);
+}
+
+void copyArguments(Diagnostic& diagnostic, Arena& arena) {
+    for (size_t i = 0; i < diagnostic.argumentCount; ++i) {
+        DiagnosticArgument& argument = diagnostic.arguments[i];
+        if (argument.kind == DiagnosticArgument::Kind::String) {
+            argument.string = arena.copyString(argument.string);
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#include "Diagnostics/DiagnosticBuffer.hpp"
+
+#include "Diagnostics/Diagnostic.hpp"
+
+void DiagnosticBuffer::addDiagnostic(const Diagnostic& diagnostic) {
+    copyArguments(m_diagnostics.emplace_back(diagnostic), m_arguments);
+    if (diagnostic.level == DiagnosticLevel::Error || diagnostic.level == DiagnosticLevel::Fatal) {
+        m_errorCount += 1;
+    }
+}
+
+void DiagnosticBuffer::flush(IDiagnosticEngine& engine) {
+    for (const Diagnostic& diagnostic : m_diagnostics) {
+        engine.addDiagnostic(diagnostic);
+    }
+    clear();
+}
+
+void DiagnosticBuffer::clear() {
+    m_diagnostics.clear();
+    m_arguments.reset();
+    m_errorCount = 0;
+}
@@ -1,24 +1,41 @@
 #include "Diagnostics/DiagnosticBuilder.hpp"
 
-#include <memory>
+#include <stdexcept>
+#include <string_view>
 
 #include "Diagnostics/Diagnostic.hpp"
 #include "Diagnostics/DiagnosticID.hpp"
 
-DiagnosticBuilder::DiagnosticBuilder(DiagnosticID id, std::string message)
-: m_diagnostic(std::make_unique<Diagnostic>()) {
+DiagnosticBuilder::DiagnosticBuilder(DiagnosticID id) {
     DiagnosticInfo info = getDiagnosticInfo(id);
-    m_diagnostic->id = id;
-    m_diagnostic->code = info.code;
-    m_diagnostic->level= info.level;
-    m_diagnostic->message = message;
+    m_diagnostic.id = id;
+    m_diagnostic.code = info.code;
+    m_diagnostic.level = info.level;
+    m_diagnostic.span = {};
 }
 
 DiagnosticBuilder& DiagnosticBuilder::span(Span span) {
-    m_diagnostic->span = span;
+    m_diagnostic.span = span;
     return *this;
 }
 
-std::unique_ptr<Diagnostic> DiagnosticBuilder::build() {
-    return std::move(m_diagnostic);
+DiagnosticArgument& DiagnosticBuilder::nextArgument() {
+    if (m_diagnostic.argumentCount >= Diagnostic::MaxArguments) {
+        throw std::out_of_range("Diagnostic arguments exceed Diagnostic::MaxArguments");
+    }
+    return m_diagnostic.arguments[m_diagnostic.argumentCount++];
+}
+
+DiagnosticBuilder& DiagnosticBuilder::argument(std::string_view string) {
+    nextArgument() = { .kind = DiagnosticArgument::Kind::String, .codepoint = 0, .string = string };
+    return *this;
+}
+
+DiagnosticBuilder& DiagnosticBuilder::argument(char32_t codepoint) {
+    nextArgument() = { .kind = DiagnosticArgument::Kind::Codepoint, .codepoint = codepoint, .string = {} };
+    return *this;
+}
+
+Diagnostic DiagnosticBuilder::build() const {
+    return m_diagnostic;
 }
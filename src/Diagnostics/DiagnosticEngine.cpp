@@ -1,21 +1,156 @@
 #include "Diagnostics/DiagnosticEngine.hpp"
 
+#include <span>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <algorithm>
+
 #include <fmt/color.h>
 
 #include "Diagnostics/Diagnostic.hpp"
+#include "Diagnostics/DiagnosticBuilder.hpp"
 #include "SourceManager/SourceManager.hpp"
 
-DiagnosticEngine::DiagnosticEngine(ISourceManager& sourceManager) : m_sourceManager(sourceManager) {}
+namespace {
+    std::atomic<uint64_t> nextEngineID = 1;
+
+    // The shard this thread last reported to, reporters rarely alternate between engines
+    struct ThreadShardCache {
+        uint64_t engineID = 0;
+        void* shard = nullptr;
+    };
+    thread_local ThreadShardCache threadShardCache;
+
+    // Total order on everything a diagnostic reports, ties are indistinguishable when printed
+    bool diagnosticLess(const Diagnostic& lhs, const Diagnostic& rhs) {
+        if (lhs.span.fileID != rhs.span.fileID) {
+            return lhs.span.fileID < rhs.span.fileID;
+        }
+        if (lhs.span.offset != rhs.span.offset) {
+            return lhs.span.offset < rhs.span.offset;
+        }
+        if (lhs.id != rhs.id) {
+            return lhs.id < rhs.id;
+        }
+        if (lhs.argumentCount != rhs.argumentCount) {
+            return lhs.argumentCount < rhs.argumentCount;
+        }
+        for (size_t i = 0; i < lhs.argumentCount; ++i) {
+            const DiagnosticArgument& left = lhs.arguments[i];
+            const DiagnosticArgument& right = rhs.arguments[i];
+            if (left.kind != right.kind) {
+                return left.kind < right.kind;
+            }
+            if (left.codepoint != right.codepoint) {
+                return left.codepoint < right.codepoint;
+            }
+            if (left.string != right.string) {
+                return left.string < right.string;
+            }
+        }
+        return false;
+    }
+}
+
+DiagnosticEngine::DiagnosticEngine(ISourceManager& sourceManager, size_t errorLimit)
+:   m_sourceManager(sourceManager),
+    m_engineID(nextEngineID.fetch_add(1, std::memory_order_relaxed)),
+    m_errorLimit(errorLimit),
+    m_errorLimitText(std::to_string(errorLimit)) {}
+
+void DiagnosticEngine::addDiagnostic(const Diagnostic& diagnostic) {
+    if (shouldAbort()) {
+        return;
+    }
+
+    switch (diagnostic.level) {
+        case DiagnosticLevel::Error:
+        case DiagnosticLevel::Fatal: {
+            // Reserve the slot first, so racing threads never accept more than the limit
+            const size_t errorCount = m_errorCount.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (m_errorLimit != NoErrorLimit && errorCount > m_errorLimit) {
+                m_errorCount.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            if (errorCount == m_errorLimit) {
+                m_fatal = DiagnosticBuilder(DiagnosticID::TooManyErrors).span(diagnostic.span).argument(m_errorLimitText).build();
+                m_diagnosticCount.fetch_add(1, std::memory_order_relaxed);
+                m_aborted.store(true, std::memory_order_release);
+            }
+            break;
+        }
+        case DiagnosticLevel::Warning: m_warningCount.fetch_add(1, std::memory_order_relaxed); break;
+        case DiagnosticLevel::Note: break;
+    }
 
-void DiagnosticEngine::addDiagnostic(std::unique_ptr<Diagnostic> diagnostic) {
-    m_diagnostics.push_back(std::move(diagnostic));
+    Shard& shard = getThreadShard();
+    copyArguments(shard.diagnostics.emplace_back(diagnostic), shard.arguments);
+    m_diagnosticCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+DiagnosticEngine::Shard& DiagnosticEngine::getThreadShard() {
+    if (threadShardCache.engineID == m_engineID) [[likely]] {
+        return *static_cast<Shard*>(threadShardCache.shard);
+    }
+    return acquireThreadShard();
+}
+
+DiagnosticEngine::Shard& DiagnosticEngine::acquireThreadShard() {
+    std::lock_guard<std::mutex> lock(m_shardMutex);
+    Shard*& shard = m_threadShards[std::this_thread::get_id()];
+    if (shard == nullptr) {
+        shard = m_shards.emplace_back(std::make_unique<Shard>()).get();
+    }
+    threadShardCache = ThreadShardCache{ .engineID = m_engineID, .shard = shard };
+    return *shard;
+}
+
+std::span<const Diagnostic> DiagnosticEngine::getDiagnostics() {
+    const size_t count = getDiagnosticCount();
+    if (m_mergedCount == count) {
+        return m_merged;
+    }
+
+    // Arguments stay in the shard arenas, the merged copies reference them
+    m_merged.clear();
+    m_merged.reserve(count);
+    for (const std::unique_ptr<Shard>& shard : m_shards) {
+        m_merged.insert(m_merged.end(), shard->diagnostics.begin(), shard->diagnostics.end());
+    }
+    std::stable_sort(m_merged.begin(), m_merged.end(), diagnosticLess);
+    if (m_fatal.has_value()) {
+        m_merged.push_back(m_fatal.value());
+    }
+    m_mergedCount = count;
+    return m_merged;
+}
+
+std::span<const Diagnostic> DiagnosticEngine::getNewDiagnostics() {
+    m_newDiagnostics.clear();
+    m_newShardCounts.resize(m_shards.size(), 0);
+    for (size_t i = 0; i < m_shards.size(); ++i) {
+        const std::vector<Diagnostic>& diagnostics = m_shards[i]->diagnostics;
+        m_newDiagnostics.insert(m_newDiagnostics.end(), diagnostics.begin() + m_newShardCounts[i], diagnostics.end());
+        m_newShardCounts[i] = diagnostics.size();
+    }
+    std::stable_sort(m_newDiagnostics.begin(), m_newDiagnostics.end(), diagnosticLess);
+
+    if (m_fatal.has_value() && !m_hasReturnedFatal) {
+        m_newDiagnostics.push_back(m_fatal.value());
+        m_hasReturnedFatal = true;
+    }
+    return m_newDiagnostics;
 }
 
 void DiagnosticEngine::printDiagnostics() {
-    for (auto& diagnostic : m_diagnostics) {
-        Span span = diagnostic->span;
-        fmt::print(fmt::bg(fmt::rgb(255, 96, 93)) | fmt::fg(fmt::color::black) | fmt::emphasis::bold, " Error[{}] ", diagnostic->code);
-        fmt::println(" {}", diagnostic->message);
-        fmt::println("--> {}:{}:{}", m_sourceManager.getPath(span.fileID), span.line, span.column);
+    for (const Diagnostic& diagnostic : getDiagnostics()) {
+        Span span = diagnostic.span;
+        fmt::print(fmt::bg(fmt::rgb(255, 96, 93)) | fmt::fg(fmt::color::black) | fmt::emphasis::bold, " Error[{}] ", diagnostic.code);
+        fmt::println(" {}", formatMessage(diagnostic));
+        auto [line, column] = m_sourceManager.getLineTable(span.fileID).getLineColumn(span.offset);
+        fmt::println("--> {}:{}:{}", m_sourceManager.getPath(span.fileID), line, column);
     }
 }
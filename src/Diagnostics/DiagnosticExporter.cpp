@@ -0,0 +1,168 @@
+#include "Diagnostics/DiagnosticExporter.hpp"
+
+#include <cstdio>
+#include <iterator>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "Diagnostics/Diagnostic.hpp"
+#include "Diagnostics/DiagnosticID.hpp"
+#include "SourceManager/SourceManager.hpp"
+#include "Utils/Utf8.hpp"
+
+namespace {
+    constexpr std::string_view SarifHeader =
+        R"({"version":"2.1.0","$schema":"https://json.schemastore.org/sarif-2.1.0.json",)"
+        R"("runs":[{"tool":{"driver":{"name":"blaze","informationUri":"https://github.com/blazelang/blaze"}},)"
+        R"("columnKind":"unicodeCodePoints","results":[)";
+    constexpr std::string_view SarifFooter = "]}]}\n";
+
+    std::string_view levelName(DiagnosticLevel level) {
+        switch (level) {
+            case DiagnosticLevel::Note: return "note";
+            case DiagnosticLevel::Warning: return "warning";
+            case DiagnosticLevel::Error: return "error";
+            case DiagnosticLevel::Fatal: return "fatal";
+        }
+        return "error";
+    }
+
+    // SARIF has no fatal level, fatal diagnostics are errors that ended the run
+    std::string_view sarifLevelName(DiagnosticLevel level) {
+        return level == DiagnosticLevel::Fatal ? "error" : levelName(level);
+    }
+}
+
+DiagnosticExporter::DiagnosticExporter(Format format, const ISourceManager& sourceManager, std::FILE* output)
+:   m_format(format),
+    m_sourceManager(sourceManager),
+    m_output(output) {}
+
+DiagnosticExporter::~DiagnosticExporter() {
+    finish();
+}
+
+void DiagnosticExporter::write(const Diagnostic& diagnostic) {
+    switch (m_format) {
+        case Format::JsonLines: writeJsonLine(diagnostic); break;
+        case Format::Sarif: writeSarifResult(diagnostic); break;
+    }
+    m_resultCount += 1;
+
+    if (m_buffer.size() >= BufferSize) {
+        writeBuffer();
+    }
+}
+
+void DiagnosticExporter::finish() {
+    if (m_isFinished) {
+        return;
+    }
+    m_isFinished = true;
+
+    if (m_format == Format::Sarif) {
+        if (m_resultCount == 0) {
+            m_buffer.append(SarifHeader);
+        }
+        m_buffer.append(SarifFooter);
+    }
+    flush();
+}
+
+void DiagnosticExporter::flush() {
+    writeBuffer();
+    std::fflush(m_output);
+}
+
+void DiagnosticExporter::writeJsonLine(const Diagnostic& diagnostic) {
+    const Span span = diagnostic.span;
+    const auto [line, column] = m_sourceManager.getLineTable(span.fileID).getLineColumn(span.offset);
+
+    auto out = std::back_inserter(m_buffer);
+    fmt::format_to(out, R"({{"code":"{}","level":"{}","message":)", diagnostic.code, levelName(diagnostic.level));
+    writeString(formatMessage(diagnostic));
+    fmt::format_to(out, R"(,"span":{{"fileID":{},"path":)", span.fileID);
+    writeString(m_sourceManager.getPath(span.fileID));
+    fmt::format_to(out, R"(,"offset":{},"line":{},"column":{}}}}})" "\n", span.offset, line, column);
+}
+
+void DiagnosticExporter::writeSarifResult(const Diagnostic& diagnostic) {
+    const Span span = diagnostic.span;
+    const auto [line, column] = m_sourceManager.getLineTable(span.fileID).getLineColumn(span.offset);
+
+    m_buffer.append(m_resultCount == 0 ? SarifHeader : std::string_view(","));
+    auto out = std::back_inserter(m_buffer);
+    fmt::format_to(out, R"({{"ruleId":"{}","level":"{}","message":{{"text":)", diagnostic.code, sarifLevelName(diagnostic.level));
+    writeString(formatMessage(diagnostic));
+    m_buffer.append(std::string_view(R"(},"locations":[{"physicalLocation":{"artifactLocation":{"uri":)"));
+    writeUri(m_sourceManager.getPath(span.fileID));
+    fmt::format_to(out, R"(}},"region":{{"startLine":{},"startColumn":{},"byteOffset":{}}}}}}}]}})", line, column, span.offset);
+}
+
+// Writes `text` as a JSON string literal. Source bytes that are not valid UTF-8, which can end
+// up in arguments, become U+FFFD so the output always parses
+void DiagnosticExporter::writeString(std::string_view text) {
+    auto out = std::back_inserter(m_buffer);
+    m_buffer.push_back('"');
+
+    size_t i = 0;
+    while (i < text.size()) {
+        const uint8_t byte = static_cast<uint8_t>(text[i]);
+        if (byte >= 0x80) {
+            char32_t cp = 0;
+            const size_t length = utf8::decodeMultiByteCodepoint(text, i, cp);
+            if (cp == 0xFFFD && length == 1) {
+                m_buffer.append(std::string_view("\\ufffd"));
+            } else {
+                m_buffer.append(text.substr(i, length));
+            }
+            i += length;
+            continue;
+        }
+
+        switch (byte) {
+            case '"': m_buffer.append(std::string_view("\\\"")); break;
+            case '\\': m_buffer.append(std::string_view("\\\\")); break;
+            case '\n': m_buffer.append(std::string_view("\\n")); break;
+            case '\r': m_buffer.append(std::string_view("\\r")); break;
+            case '\t': m_buffer.append(std::string_view("\\t")); break;
+            default:
+                if (byte < 0x20) {
+                    fmt::format_to(out, "\\u{:04x}", byte);
+                } else {
+                    m_buffer.push_back(static_cast<char>(byte));
+                }
+                break;
+        }
+        i += 1;
+    }
+
+    m_buffer.push_back('"');
+}
+
+// Writes `path` as a JSON string holding a URI reference. Bytes outside the unreserved set and
+// `/` are percent-encoded, which also keeps the string free of characters JSON escapes
+void DiagnosticExporter::writeUri(std::string_view path) {
+    auto out = std::back_inserter(m_buffer);
+    m_buffer.push_back('"');
+    if (path.starts_with('/')) {
+        m_buffer.append(std::string_view("file://"));
+    }
+    for (const char c : path) {
+        const uint8_t byte = static_cast<uint8_t>(c);
+        const bool isUnreserved = (byte >= 'A' && byte <= 'Z') || (byte >= 'a' && byte <= 'z') || (byte >= '0' && byte <= '9')
+            || byte == '-' || byte == '.' || byte == '_' || byte == '~' || byte == '/';
+        if (isUnreserved) {
+            m_buffer.push_back(c);
+        } else {
+            fmt::format_to(out, "%{:02X}", byte);
+        }
+    }
+    m_buffer.push_back('"');
+}
+
+void DiagnosticExporter::writeBuffer() {
+    std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_output);
+    m_buffer.clear();
+}
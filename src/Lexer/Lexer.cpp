@@ -1,31 +1,94 @@
 #include "Lexer/Lexer.hpp"
 
 #include <optional>
+#include <algorithm>
+#include <stdexcept>
 #include <string>
-#include <format>
 #include <string_view>
 
 #include "Diagnostics/Diagnostic.hpp"
 #include "Diagnostics/DiagnosticID.hpp"
 #include "Diagnostics/DiagnosticBuilder.hpp"
 #include "Lexer/Token.hpp"
+#include "Lexer/KeywordTable.hpp"
+#include "Lexer/SymbolTable.hpp"
 #include "Utils/Utf8.hpp"
+#include "Utils/Unicode.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Every buffer is followed by SourceBuffer::Padding NUL bytes, see ISourceManager. Scanning
+// loops stop on NUL and only then compare against the size, since NUL may also be content.
+namespace {
+    // Same set as Lexer::isWhitespace, NUL is not in it so a run always ends at the sentinel
+    bool isWhitespaceByte(uint8_t byte) {
+        return byte == ' ' || (byte >= '\t' && byte <= '\r');
+    }
+
+    // First position at or after `pos` holding `a`, `b` or NUL. Whole 16-byte blocks are loaded,
+    // the last one at most 15 bytes past the sentinel, well inside the padding.
+    size_t scanUntil(const char* data, size_t pos, char a, char b) {
+#if defined(__SSE2__)
+        const __m128i first = _mm_set1_epi8(a);
+        const __m128i second = _mm_set1_epi8(b);
+        const __m128i zero = _mm_setzero_si128();
+        while (true) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+            const __m128i hits = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, first), _mm_cmpeq_epi8(block, second)),
+                _mm_cmpeq_epi8(block, zero)
+            );
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+            if (mask != 0) {
+                return pos + __builtin_ctz(mask);
+            }
+            pos += 16;
+        }
+#else
+        while (data[pos] != a && data[pos] != b && data[pos] != '\0') {
+            pos += 1;
+        }
+        return pos;
+#endif
+    }
+}
 
 Lexer::Lexer(ISourceManager::FileID fileID, ISourceManager& sourceManager, IDiagnosticEngine& diagnosticEngine)
 :   m_fileID(fileID),
     m_sourceManager(sourceManager),
     m_diagnosticEngine(diagnosticEngine),
-    m_source(sourceManager.getBuffer(fileID)) {}
+    m_source(sourceManager.getBuffer(fileID)),
+    m_aborted(diagnosticEngine.shouldAbort()) {}
+
+Lexer::Lexer(ISourceManager::FileID fileID, ISourceManager& sourceManager, IDiagnosticEngine& diagnosticEngine, size_t start, size_t limit)
+:   Lexer(fileID, sourceManager, diagnosticEngine) {
+    m_pos = start;
+    m_limit = limit;
+}
 
 char32_t Lexer::advance() {
+    // Bytes 0x01-0x7F need neither decoding nor an end check, NUL and multi-byte sequences
+    // go through the full decoder, which also handles the sentinel
+    const uint8_t byte = static_cast<uint8_t>(m_source.data()[m_pos]);
+    if (byte - 1u < 0x7Fu) [[likely]] {
+        m_pos += 1;
+        return byte;
+    }
+
     char32_t cp = 0;
     size_t bytes = utf8::decodeCodepoint(m_source, m_pos, cp);
     m_pos += bytes;
-    m_endColumn += 1;
     return cp;
 };
 
 char32_t Lexer::peek() const {
+    const uint8_t byte = static_cast<uint8_t>(m_source.data()[m_pos]);
+    if (byte - 1u < 0x7Fu) [[likely]] {
+        return byte;
+    }
+
     char32_t cp = 0;
     utf8::decodeCodepoint(m_source, m_pos, cp);
     return cp;
@@ -35,11 +98,16 @@ char32_t Lexer::lookahead(int i) const {
     char32_t cp = 0;
     size_t pos = m_pos;
     for (int count = 0; count <= i; ++count) {
+        const uint8_t byte = static_cast<uint8_t>(m_source.data()[pos]);
+        if (byte - 1u < 0x7Fu) [[likely]] {
+            cp = byte;
+            pos += 1;
+            continue;
+        }
         if (pos >= m_source.size()) {
             return U'\0'; // End of source
         }
-        size_t bytes = utf8::decodeCodepoint(m_source, pos, cp);
-        pos += bytes;
+        pos += utf8::decodeCodepoint(m_source, pos, cp);
     }
     return cp;
 };
@@ -56,16 +124,57 @@ std::string_view Lexer::getLexeme() const {
     return m_source.substr(m_start, m_pos - m_start);
 }
 
-void Lexer::addToken(TokenKind kind, const std::optional<std::string>& lexeme) {
-    m_tokens.push_back({
+std::string_view Lexer::getLexeme(const Token& token) const {
+    if (token.spelling != Token::NoSpelling) {
+        return m_spellings[token.spelling];
+    }
+    return m_source.substr(token.offset, token.length);
+}
+
+void Lexer::addToken(TokenKind kind, uint32_t spelling) {
+    m_lookahead.push_back({
         .kind = kind,
-        .position = std::pair(m_startLine, m_startColumn),
-        .lexeme = lexeme.value_or(std::string(getLexeme()))
+        .offset = m_start,
+        .length = static_cast<uint32_t>(m_pos - m_start),
+        .spelling = spelling
     });
 }
 
-std::unique_ptr<Diagnostic> Lexer::buildDiagnostic(DiagnosticID id, std::string message, Span span) {
-    return DiagnosticBuilder(id, message).span(span).build();
+void Lexer::reportDiagnostic(const Diagnostic& diagnostic) {
+    m_diagnosticEngine.addDiagnostic(diagnostic);
+    m_aborted = m_diagnosticEngine.shouldAbort();
+}
+
+void Lexer::reuseSpellings(size_t first, size_t tail, std::vector<Token>& relexed, size_t spellingBase) {
+    // Slots of the replaced tokens become free, so repeated edits do not grow `m_spellings`
+    for (size_t i = first; i < tail; ++i) {
+        if (m_tokens[i].spelling != Token::NoSpelling) {
+            std::string().swap(m_spellings[m_tokens[i].spelling]);
+            m_freeSpellings.push_back(m_tokens[i].spelling);
+        }
+    }
+
+    // Spellings appended by the relex move into free slots or are compacted at the end. They
+    // were appended in token order, so a slot written here was already moved out of. Spellings
+    // of lexed tokens that were not kept, such as the one resynchronized on, are dropped
+    size_t appendedCount = spellingBase;
+    for (Token& token : relexed) {
+        if (token.spelling == Token::NoSpelling) {
+            continue;
+        }
+        size_t slot = appendedCount;
+        if (!m_freeSpellings.empty()) {
+            slot = m_freeSpellings.back();
+            m_freeSpellings.pop_back();
+        } else {
+            appendedCount += 1;
+        }
+        if (slot != token.spelling) {
+            m_spellings[slot] = std::move(m_spellings[token.spelling]);
+        }
+        token.spelling = static_cast<uint32_t>(slot);
+    }
+    m_spellings.resize(appendedCount);
 }
 
 bool Lexer::isEnd() const {
@@ -128,20 +237,13 @@ bool Lexer::isAlphaNum(char32_t codepoint) const {
 }
 
 bool Lexer::isIdentifierStart(char32_t cp) {
-    return u_hasBinaryProperty(cp, UCHAR_XID_START) || cp == U'_';
+    return unicode::isXIDStart(cp) || cp == U'_';
 };
 
 bool Lexer::isIdentifierContinue(char32_t cp) {
-    return u_hasBinaryProperty(cp, UCHAR_XID_CONTINUE);
+    return unicode::isXIDContinue(cp);
 };
 
-void Lexer::skipWhitespace(char32_t codepoint) {
-    if (codepoint == U'\n') {
-        m_endLine += 1;
-        m_endColumn = 1;
-    }
-}
-
 void Lexer::lexLineComment() {
     std::optional<TokenKind> token;
 
@@ -151,8 +253,13 @@ void Lexer::lexLineComment() {
         token = TOK_DOC_COMMENT_LINE_INNER;
     }
 
-    while (!isEnd() && peek() != U'\n') {
-        advance();
+    // Comment bytes are never decoded, UTF-8 continuation bytes cannot look like a newline
+    while (true) {
+        m_pos = scanUntil(m_source.data(), m_pos, '\n', '\n');
+        if (m_source.data()[m_pos] == '\n' || isEnd()) {
+            break;
+        }
+        m_pos += 1; // NUL inside the comment
     }
 
     if (token.has_value()) {
@@ -170,15 +277,30 @@ void Lexer::lexBlockComment() {
         token = TOK_DOC_COMMENT_BLOCK_INNER;
     }
 
-    while (!isEnd()) {
-        if (peek() == U'/' && lookahead() == U'*') {
+    // Only '/' and '*' matter, everything between them is skipped a block at a time
+    const char* data = m_source.data();
+    while (true) {
+        m_pos = scanUntil(data, m_pos, '/', '*');
+        if (data[m_pos] == '\0') {
+            if (isEnd()) {
+                break;
+            }
+            m_pos += 1;
+            continue;
+        }
+
+        // The byte after is readable even at the end, it is then the sentinel
+        if (data[m_pos] == '/' && data[m_pos + 1] == '*') {
             // Nested opening block comment
-            advance(); advance();
+            m_pos += 2;
             depth++;
-        } else if (peek() == U'*' && lookahead() == U'/') {
+        } else if (data[m_pos] == '*' && data[m_pos + 1] == '/') {
             // Closing block comment
-            advance(); advance();
+            m_pos += 2;
             depth--;
+        } else {
+            m_pos += 1;
+            continue;
         }
 
         // Break if depth is zero, found closing delimiter for block comment
@@ -186,23 +308,17 @@ void Lexer::lexBlockComment() {
             break;
         }
 
-        if (peek() == U'\n') {
-            m_endLine += 1;
-            m_endColumn = 1;
-        }
-
+        // The character right after a nested delimiter is skipped unexamined
         advance();
     }
 
     // Handle the case where the comment is unterminated (depth > 0)
     if (depth > 0) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::BlockCommentUnterminated,
-                    std::format("Unterminated {} comment", token.has_value() ? "document" : "block"),
-                    { m_fileID, m_startLine, m_startColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::BlockCommentUnterminated,
+                { m_fileID, m_start },
+                token.has_value() ? "document" : "block"
             )
         );
 
@@ -215,22 +331,42 @@ void Lexer::lexBlockComment() {
 }
 
 void Lexer::lexKeywordOrIdentifier() {
-    // Keep advancing codepoints as long as they are valid continuation characters
-    while (!isEnd() && isIdentifierContinue(peek())) {
+    bool isAscii = static_cast<uint8_t>(m_source[m_start]) < 0x80;
+
+    // Scan the ASCII run byte by byte, the bitmap answers without decoding
+    // The sentinel NUL is not XID_Continue, so the run needs no end check
+    while (static_cast<uint8_t>(m_source.data()[m_pos]) < 0x80 &&
+           (unicode::g_asciiClass[static_cast<uint8_t>(m_source.data()[m_pos])] & unicode::ASCII_XID_CONTINUE)) {
+        m_pos += 1;
+    }
+
+    // Keep advancing codepoints as long as they are valid continuation characters, U+FFFD past the end is not one
+    while (isIdentifierContinue(peek())) {
+        isAscii &= static_cast<uint8_t>(m_source.data()[m_pos]) < 0x80;
         advance();
     }
 
+    // ASCII is already in NFKC form, so the lexeme can be matched in place without normalizing
+    if (isAscii) {
+        std::optional<TokenKind> keyword = keywords::lookup(getLexeme());
+        return addToken(keyword.value_or(TOK_IDENTIFIER));
+    }
+
     std::string normalizedUTF8Lexeme = utf8::normalizeToNFKC(getLexeme());
 
-    // Look up the normalized lexeme in the keyword map
-    auto keywordIt = g_keywordMap.find(normalizedUTF8Lexeme);
+    // If the normalized lexeme is a keyword, add the keyword token, otherwise add it as an identifier
+    std::optional<TokenKind> keyword = keywords::lookup(normalizedUTF8Lexeme);
+    if (keyword.has_value()) {
+        return addToken(keyword.value());
+    }
 
-    // If it's a keyword, add the keyword token, otherwise add it as an identifier
-    if (keywordIt != g_keywordMap.end()) {
-        return addToken(keywordIt->second);
+    // Only keep a separate spelling when normalization actually changed the lexeme
+    if (normalizedUTF8Lexeme != getLexeme()) {
+        m_spellings.push_back(std::move(normalizedUTF8Lexeme));
+        return addToken(TOK_IDENTIFIER, static_cast<uint32_t>(m_spellings.size() - 1));
     }
 
-    addToken(TOK_IDENTIFIER, normalizedUTF8Lexeme);
+    addToken(TOK_IDENTIFIER);
 }
 
 void Lexer::lexNumberLiteral(char32_t codepoint) {
@@ -250,8 +386,7 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     bool hasUnderscoreAfterBasePrefix = false;
     bool hasUnderscoreBeforeDot = false;
 
-    size_t invalidLine = m_startLine;
-    size_t invalidColumn = m_startColumn;
+    size_t invalidOffset = m_start;
 
     // Case when the literal starts with '.' (e.g., ".123") which is invalid
     if (codepoint == U'.') {
@@ -362,8 +497,7 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
 
         // check for atleast one valid decimal digit for exponent is found
         if (!isDecimalDigit(peek())) {
-            invalidLine = m_endLine;
-            invalidColumn = m_endColumn;
+            invalidOffset = m_pos;
             hasEmptyExponent = true; // e.g., "1.0e"
         }
 
@@ -403,8 +537,7 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
 
     // Catch any remaining invalid suffix
     if (isAlphaNum(peek())) {
-        invalidLine = m_endLine;
-        invalidColumn = m_endColumn;
+        invalidOffset = m_pos;
         while (isAlphaNum(peek())) {
             invalidSuffix += advance();
         }
@@ -413,13 +546,10 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     // Final validations and error reports
 
     if (hasInValidDigit) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::NumberLiteralInvalidDigit,
-                    "Numeric literal contains invalid digit(s)",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::NumberLiteralInvalidDigit,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -427,13 +557,10 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     }
 
     if (hasEmptyDigit) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::NumberLiteralEmptyDigits,
-                    "Numeric literal contains no digits",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::NumberLiteralEmptyDigits,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -441,13 +568,10 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     }
 
     if (hasLeadingDot) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::NumberLiteralLeadingDot,
-                    "Floating-point literals must include digits before the decimal point",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::NumberLiteralLeadingDot,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -455,13 +579,10 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     }
 
     if (hasMultipleDot) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::NumberLiteralMultipleDots,
-                    "Numeric literal contains multiple decimal points",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::NumberLiteralMultipleDots,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -469,13 +590,10 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     }
 
     if (hasEmptyExponent) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::NumberLiteralEmptyExponent,
-                    "Exponent in numeric literal must contain at least one digit",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::NumberLiteralEmptyExponent,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -483,13 +601,10 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     }
 
     if (hasConsecutiveUnderscore) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::NumberLiteralConsecutiveUnderscore,
-                    "Consecutive underscores are not permitted within numeric literals",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::NumberLiteralConsecutiveUnderscore,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -497,13 +612,10 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     }
 
     if (hasTailingUnderscore) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::NumberLiteralTrailingUnderscore,
-                    "Numeric literals cannot end with an underscore",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::NumberLiteralTrailingUnderscore,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -511,13 +623,10 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     }
 
     if (hasUnderscoreBeforeBasePrefix) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::NumberLiteralUnderscoreBeforePrefix,
-                    "Underscores are not allowed before the base prefix in numeric literals",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::NumberLiteralUnderscoreBeforePrefix,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -525,13 +634,10 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     }
 
     if (hasUnderscoreAfterBasePrefix) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::NumberLiteralUnderscoreAfterPrefix,
-                    "Underscores are not allowed immediately after the base prefix in numeric literals",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::NumberLiteralUnderscoreAfterPrefix,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -539,13 +645,10 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     }
 
     if (hasUnderscoreBeforeDot) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::NumberLiteralUnderscoreBeforeDot,
-                    "Underscores are not allowed immediately before the decimal point in numeric literals",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::NumberLiteralUnderscoreBeforeDot,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -553,13 +656,11 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
     }
 
     if (invalidSuffix.size() > 0) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::NumberLiteralInvalidSuffix,
-                    std::format("Invalid suffix `{}` on number literal", invalidSuffix),
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::NumberLiteralInvalidSuffix,
+                { m_fileID, invalidOffset },
+                invalidSuffix
             )
         );
 
@@ -570,8 +671,7 @@ void Lexer::lexNumberLiteral(char32_t codepoint) {
 }
 
 bool Lexer::lexEscapeSequence(bool isChar) {
-    size_t startLine = m_endLine;
-    size_t startColumn = m_endColumn;
+    size_t startOffset = m_pos;
 
     advance(); // consume `\`
 
@@ -593,13 +693,10 @@ bool Lexer::lexEscapeSequence(bool isChar) {
 
             for (int i = 0; i < 2; ++i) {
                 if (peek() == U'\'' || peek() == U'\"') {
-                    m_diagnosticEngine.addDiagnostic(
-                        std::move(
-                            buildDiagnostic(
-                                isChar ? DiagnosticID::CharEscapeHexTooShort : DiagnosticID::StringEscapeHexTooShort,
-                                "numeric character escape is too short",
-                                { m_fileID, startLine, startColumn }
-                            )
+                    reportDiagnostic(
+                        buildDiagnostic(
+                            isChar ? DiagnosticID::CharEscapeHexTooShort : DiagnosticID::StringEscapeHexTooShort,
+                            { m_fileID, startOffset }
                         )
                     );
 
@@ -607,13 +704,11 @@ bool Lexer::lexEscapeSequence(bool isChar) {
                 }
 
                 if (!isHexDigit(peek())) {
-                    m_diagnosticEngine.addDiagnostic(
-                        std::move(
-                            buildDiagnostic(
-                                isChar ? DiagnosticID::CharEscapeInvalidHexDigit : DiagnosticID::StringEscapeInvalidHexDigit,
-                                std::format("invalid character in numeric character escape: `{}`", m_source[m_pos]),
-                                { m_fileID, m_endLine, m_endColumn }
-                            )
+                    reportDiagnostic(
+                        buildDiagnostic(
+                            isChar ? DiagnosticID::CharEscapeInvalidHexDigit : DiagnosticID::StringEscapeInvalidHexDigit,
+                            { m_fileID, m_pos },
+                            peek()
                         )
                     );
 
@@ -629,28 +724,22 @@ bool Lexer::lexEscapeSequence(bool isChar) {
 
                // Check for 00-7F range
                 if (value > 0x7F) {
-                    m_diagnosticEngine.addDiagnostic(
-                        std::move(
-                            buildDiagnostic(
-                                isChar ?
-                                    DiagnosticID::CharEscapeHexOutOfRange :
-                                    DiagnosticID::StringEscapeHexOutOfRange,
-                                "out of range hex escape",
-                                { m_fileID, startLine, startColumn }
-                            )
+                    reportDiagnostic(
+                        buildDiagnostic(
+                            isChar ?
+                                DiagnosticID::CharEscapeHexOutOfRange :
+                                DiagnosticID::StringEscapeHexOutOfRange,
+                            { m_fileID, startOffset }
                         )
                     );
 
                     return false;
                 }
             } catch (const std::exception&) {
-                m_diagnosticEngine.addDiagnostic(
-                    std::move(
-                        buildDiagnostic(
-                            isChar ? DiagnosticID::CharEscapeHexOutOfRange : DiagnosticID::StringEscapeHexOutOfRange,
-                            "out of range hex escape",
-                            { m_fileID, startLine, startColumn }
-                        )
+                reportDiagnostic(
+                    buildDiagnostic(
+                        isChar ? DiagnosticID::CharEscapeHexOutOfRange : DiagnosticID::StringEscapeHexOutOfRange,
+                        { m_fileID, startOffset }
                     )
                 );
 
@@ -665,13 +754,10 @@ bool Lexer::lexEscapeSequence(bool isChar) {
             advance(); // Consume 'u'
 
             if (!match(U'{')) {
-                m_diagnosticEngine.addDiagnostic(
-                    std::move(
-                        buildDiagnostic(
-                            isChar ? DiagnosticID::CharEscapeMissingUnicodeBrace : DiagnosticID::StringEscapeMissingUnicodeBrace,
-                            "incorrect unicode escape sequence",
-                            { m_fileID, startLine, startColumn }
-                        )
+                reportDiagnostic(
+                    buildDiagnostic(
+                        isChar ? DiagnosticID::CharEscapeMissingUnicodeBrace : DiagnosticID::StringEscapeMissingUnicodeBrace,
+                        { m_fileID, startOffset }
                     )
                 );
 
@@ -683,13 +769,11 @@ bool Lexer::lexEscapeSequence(bool isChar) {
 
             while (!isEnd() && peek() != U'\'' && peek() != U'\"' && peek() != U'}') {
                 if (!isHexDigit(peek())) {
-                    m_diagnosticEngine.addDiagnostic(
-                        std::move(
-                            buildDiagnostic(
-                                isChar ? DiagnosticID::CharEscapeInvalidUnicodeDigit : DiagnosticID::StringEscapeInvalidUnicodeDigit,
-                                std::format("invalid character in unicode escape: `{}`", m_source[m_pos]),
-                                { m_fileID, m_endLine, m_endColumn }
-                            )
+                    reportDiagnostic(
+                        buildDiagnostic(
+                            isChar ? DiagnosticID::CharEscapeInvalidUnicodeDigit : DiagnosticID::StringEscapeInvalidUnicodeDigit,
+                            { m_fileID, m_pos },
+                            peek()
                         )
                     );
 
@@ -700,13 +784,10 @@ bool Lexer::lexEscapeSequence(bool isChar) {
             }
 
             if (!match(U'}')) {
-                m_diagnosticEngine.addDiagnostic(
-                    std::move(
-                        buildDiagnostic(
-                            isChar ? DiagnosticID::CharEscapeUnterminatedUnicode : DiagnosticID::StringEscapeUnterminatedUnicode,
-                            "unterminated unicode escape",
-                            { m_fileID, startLine, startColumn }
-                        )
+                reportDiagnostic(
+                    buildDiagnostic(
+                        isChar ? DiagnosticID::CharEscapeUnterminatedUnicode : DiagnosticID::StringEscapeUnterminatedUnicode,
+                        { m_fileID, startOffset }
                     )
                 );
 
@@ -714,13 +795,10 @@ bool Lexer::lexEscapeSequence(bool isChar) {
             }
 
             if (hexDigits.empty()) {
-                m_diagnosticEngine.addDiagnostic(
-                    std::move(
-                        buildDiagnostic(
-                            isChar ? DiagnosticID::CharEscapeEmptyUnicode : DiagnosticID::StringEscapeEmptyUnicode,
-                            "empty unicode escape",
-                            { m_fileID, startLine, startColumn }
-                        )
+                reportDiagnostic(
+                    buildDiagnostic(
+                        isChar ? DiagnosticID::CharEscapeEmptyUnicode : DiagnosticID::StringEscapeEmptyUnicode,
+                        { m_fileID, startOffset }
                     )
                 );
 
@@ -728,13 +806,10 @@ bool Lexer::lexEscapeSequence(bool isChar) {
             }
 
             if (hexDigits.size() > 6) {
-                m_diagnosticEngine.addDiagnostic(
-                    std::move(
-                        buildDiagnostic(
-                            isChar ? DiagnosticID::CharEscapeOverlongUnicode : DiagnosticID::StringEscapeOverlongUnicode,
-                            "overlong unicode escape",
-                            { m_fileID, startLine, startColumn }
-                        )
+                reportDiagnostic(
+                    buildDiagnostic(
+                        isChar ? DiagnosticID::CharEscapeOverlongUnicode : DiagnosticID::StringEscapeOverlongUnicode,
+                        { m_fileID, startOffset }
                     )
                 );
 
@@ -745,13 +820,10 @@ bool Lexer::lexEscapeSequence(bool isChar) {
                uint32_t value = std::stoul(hexDigits, nullptr, 16);
 
                if (value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) {
-                    m_diagnosticEngine.addDiagnostic(
-                        std::move(
-                            buildDiagnostic(
-                                isChar ? DiagnosticID::CharEscapeInvalidUnicodeRange : DiagnosticID::StringEscapeInvalidUnicodeRange,
-                                "invalid unicode character escape",
-                                { m_fileID, startLine, startColumn }
-                            )
+                    reportDiagnostic(
+                        buildDiagnostic(
+                            isChar ? DiagnosticID::CharEscapeInvalidUnicodeRange : DiagnosticID::StringEscapeInvalidUnicodeRange,
+                            { m_fileID, startOffset }
                         )
                     );
 
@@ -759,13 +831,10 @@ bool Lexer::lexEscapeSequence(bool isChar) {
                }
             } catch (const std::out_of_range&) {
                 // Max FFFFFF is 16,777,215, fits in unsigned long. Unlikely.
-                m_diagnosticEngine.addDiagnostic(
-                    std::move(
-                        buildDiagnostic(
-                            isChar ? DiagnosticID::CharEscapeInvalidUnicodeRange : DiagnosticID::StringEscapeInvalidUnicodeRange,
-                            "invalid unicode character escape",
-                            { m_fileID, startLine, startColumn }
-                        )
+                reportDiagnostic(
+                    buildDiagnostic(
+                        isChar ? DiagnosticID::CharEscapeInvalidUnicodeRange : DiagnosticID::StringEscapeInvalidUnicodeRange,
+                        { m_fileID, startOffset }
                     )
                 );
 
@@ -776,13 +845,11 @@ bool Lexer::lexEscapeSequence(bool isChar) {
         }
 
         default: {
-            m_diagnosticEngine.addDiagnostic(
-                std::move(
-                    buildDiagnostic(
-                        isChar ? DiagnosticID::CharEscapeUnknown : DiagnosticID::StringEscapeUnknown,
-                        std::format("unknown character escape: `{}`", m_source[m_pos]),
-                        { m_fileID, m_endLine, m_endColumn }
-                    )
+            reportDiagnostic(
+                buildDiagnostic(
+                    isChar ? DiagnosticID::CharEscapeUnknown : DiagnosticID::StringEscapeUnknown,
+                    { m_fileID, m_pos },
+                    peek()
                 )
             );
 
@@ -796,17 +863,13 @@ void Lexer::lexCharLiteral() {
     bool hasUnterminatedQuote = false;
     bool hasInvalidEscapeSequence = false;
 
-    size_t invalidLine = m_startLine;
-    size_t invalidColumn = m_startColumn;
+    size_t invalidOffset = m_start;
 
     if (match('\'')) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::CharEmpty,
-                    "Character literal cannot be empty",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::CharEmpty,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -825,8 +888,7 @@ void Lexer::lexCharLiteral() {
             advance();
         }
         if (match(U'\'')) {
-            invalidLine = m_endLine;
-            invalidColumn = m_endColumn;
+            invalidOffset = m_pos;
             hasMultiCodepoint = true;
         } else {
             hasUnterminatedQuote = true;
@@ -836,13 +898,10 @@ void Lexer::lexCharLiteral() {
     }
 
     if (hasUnterminatedQuote) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::CharUnterminated,
-                    "Unterminated character literal",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::CharUnterminated,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -854,13 +913,10 @@ void Lexer::lexCharLiteral() {
     }
 
     if (hasMultiCodepoint) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::CharMultiCodepoint,
-                    "Character literal must contain only one character",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::CharMultiCodepoint,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -873,13 +929,13 @@ void Lexer::lexCharLiteral() {
 void Lexer::lexStringLiteral() {
     bool hasInvalidEscapeString = false;
 
-    size_t invalidLine = m_startLine;
-    size_t invalidColumn = m_startColumn;
+    size_t invalidOffset = m_start;
 
-    while(!isEnd() && peek() != '\"') {
-        if (peek() == U'\n') {
-            m_endLine += 1;
-            m_endColumn = 1;
+    while (true) {
+        // Plain string bytes are skipped a block at a time up to a quote, backslash or NUL
+        m_pos = scanUntil(m_source.data(), m_pos, '\"', '\\');
+        if (m_source.data()[m_pos] == '\"' || isEnd()) {
+            break;
         }
 
         if (peek() == U'\\') {
@@ -888,18 +944,15 @@ void Lexer::lexStringLiteral() {
                 hasInvalidEscapeString = true;
             }
         } else {
-            advance();
+            advance(); // NUL inside the string
         }
     }
 
     if (!match(U'\"')) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::StringUnterminated,
-                    "Unterminated string literal",
-                    { m_fileID, invalidLine, invalidColumn }
-                )
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::StringUnterminated,
+                { m_fileID, invalidOffset }
             )
         );
 
@@ -914,49 +967,47 @@ void Lexer::lexStringLiteral() {
 }
 
 void Lexer::lexSymbol(char32_t cp) {
-    std::string symbol = utf8::encodeCodepoint(cp);
-
-    auto symbolIt = g_symbolMap.find(symbol);
-    if (symbolIt == g_symbolMap.end()) {
-        m_diagnosticEngine.addDiagnostic(
-            std::move(
-                buildDiagnostic(
-                    DiagnosticID::UnrecognizedSymbol,
-                    std::format("Unrecogized symbol `{}`", symbol),
-                    { m_fileID, m_startLine, m_startColumn }
-                )
+    uint8_t state = cp < symbols::AlphabetSize ? symbols::step(symbols::StartState, static_cast<uint8_t>(cp)) : symbols::NoState;
+    if (state == symbols::NoState) {
+        reportDiagnostic(
+            buildDiagnostic(
+                DiagnosticID::UnrecognizedSymbol,
+                { m_fileID, m_start },
+                cp
             )
         );
 
         return addToken(TOK_ERROR);
     }
 
-    // Try to extend the symbol as long as it's exist
-    while (!isEnd()) {
-        // Check if the extended symbol exist
-        std::string nextSymbol = utf8::encodeCodepoint(peek());
-
-        auto extendedSymbolIt = g_symbolMap.find(symbol + nextSymbol);
-        if (extendedSymbolIt != g_symbolMap.end()) {
-            symbol += advance();
-            symbolIt = extendedSymbolIt;
-        } else {
+    // Try to extend the symbol as long as it's exist, no symbol continues with the sentinel NUL
+    while (true) {
+        uint8_t nextState = symbols::step(state, static_cast<uint8_t>(m_source.data()[m_pos]));
+        if (nextState == symbols::NoState) {
             break;
         }
+        state = nextState;
+        advance();
     }
 
-    return addToken(symbolIt->second);
+    return addToken(symbols::g_symbolDFA.accept[state]);
 }
 
-std::vector<Token>& Lexer::tokenize() {
-    while (!isEnd()) {
+void Lexer::lexToken() {
+    // Skip over whitespace and plain comments until a token is produced
+    while (!isEnd() && m_pos < m_limit && !m_aborted) {
         m_start = m_pos;
-        m_startLine = m_endLine;
-        m_startColumn = m_endColumn;
+
+        const size_t bufferedTokens = m_lookahead.size();
 
         const char32_t cp = advance();
         if (isWhitespace(cp)) {
-            skipWhitespace(cp);
+            // Whitespace produces no token, lines are resolved later from the LineTable. The
+            // rest of an ASCII run is skipped here, the sentinel ends it at the latest
+            while (m_pos < m_limit && isWhitespaceByte(static_cast<uint8_t>(m_source.data()[m_pos]))) {
+                m_pos += 1;
+            }
+            continue;
         } else if (cp == U'/' && match(U'/')) {
             lexLineComment();
         } else if (cp == U'/' && match(U'*')) {
@@ -972,18 +1023,130 @@ std::vector<Token>& Lexer::tokenize() {
         } else {
             lexSymbol(cp);
         }
+
+        if (m_lookahead.size() > bufferedTokens) {
+            return;
+        }
     }
 
     m_start = m_pos;
-    m_startLine = m_endLine;
-    m_startColumn = m_endColumn;
 
     addToken(TOK_EOF);
+    m_reachedEOF = true;
+}
+
+Token Lexer::next() {
+    if (m_lookahead.empty()) {
+        peek(0);
+    }
+
+    // Keep handing out the EOF token once the source is exhausted
+    if (m_lookahead.size() == 1 && m_lookahead.front().kind == TOK_EOF) {
+        return m_lookahead.front();
+    }
+
+    return m_lookahead.pop_front();
+}
+
+const Token& Lexer::peek(size_t n) {
+    if (n >= LookaheadCapacity) {
+        throw std::out_of_range("Lexer lookahead exceeds LookaheadCapacity");
+    }
 
-    // Reset values
-    m_start = 0; m_pos = 0;
-    m_startLine = 1; m_startColumn = 1;
-    m_endLine = 1; m_endColumn = 1;
+    while (m_lookahead.size() <= n) {
+        if (m_reachedEOF) {
+            // Everything past the end of the source is EOF
+            return m_lookahead[m_lookahead.size() - 1];
+        }
+        lexToken();
+    }
+
+    return m_lookahead[n];
+}
+
+std::vector<Token>& Lexer::tokenize() {
+    // Already complete, possibly kept up to date by `relex`
+    if (!m_tokens.empty() && m_tokens.back().kind == TOK_EOF) {
+        return m_tokens;
+    }
+
+    do {
+        m_tokens.push_back(next());
+    } while (m_tokens.back().kind != TOK_EOF);
 
     return m_tokens;
 }
+
+size_t Lexer::relex(const SourceEdit& edit) {
+    // Tokens hanging over the end of the previous buffer may only have looked ahead a couple of codepoints
+    constexpr size_t LookbehindTokens = 2;
+
+    m_source = m_sourceManager.getBuffer(m_fileID);
+
+    const size_t damageEnd = edit.offset + edit.removedLength;
+    const int64_t delta = static_cast<int64_t>(edit.insertedLength) - static_cast<int64_t>(edit.removedLength);
+
+    // The first token ending at or after the edit could merge with the inserted text
+    auto damaged = std::lower_bound(m_tokens.begin(), m_tokens.end(), edit.offset, [](const Token& token, size_t offset) {
+        return static_cast<size_t>(token.offset) + token.length < offset;
+    });
+    const size_t first = static_cast<size_t>(std::max<ptrdiff_t>(damaged - m_tokens.begin() - static_cast<ptrdiff_t>(LookbehindTokens), 0));
+
+    // Old tokens that start after the damaged bytes are candidates to resynchronize on
+    size_t tail = static_cast<size_t>(std::lower_bound(m_tokens.begin(), m_tokens.end(), damageEnd, [](const Token& token, size_t offset) {
+        return token.offset < offset;
+    }) - m_tokens.begin());
+
+    // Every token starts in the neutral state, so lexing can resume at any token start before the
+    // edit. With no token before it the edit may lie in leading trivia, so start over from 0
+    m_pos = first > 0 ? m_tokens[first].offset : 0;
+    m_limit = SIZE_MAX;
+    m_lookahead.clear();
+    m_reachedEOF = false;
+    m_aborted = m_diagnosticEngine.shouldAbort();
+
+    const size_t spellingBase = m_spellings.size();
+    std::vector<Token> relexed;
+    while (true) {
+        const Token token = next();
+
+        while (tail < m_tokens.size() && static_cast<int64_t>(m_tokens[tail].offset) + delta < static_cast<int64_t>(token.offset)) {
+            tail += 1;
+        }
+
+        // Same bytes from the same neutral start, the rest of the old stream is still valid
+        if (tail < m_tokens.size() && static_cast<int64_t>(m_tokens[tail].offset) + delta == static_cast<int64_t>(token.offset)) {
+            break;
+        }
+
+        relexed.push_back(token);
+        if (token.kind == TOK_EOF) {
+            tail = m_tokens.size();
+            break;
+        }
+    }
+
+    for (size_t i = tail; i < m_tokens.size(); ++i) {
+        m_tokens[i].offset = static_cast<uint64_t>(static_cast<int64_t>(m_tokens[i].offset) + delta);
+    }
+
+    reuseSpellings(first, tail, relexed, spellingBase);
+
+    // Splice the relexed tokens over the damaged range, reusing slots where the counts overlap
+    const size_t replaced = tail - first;
+    const size_t reused = std::min(replaced, relexed.size());
+    std::copy(relexed.begin(), relexed.begin() + reused, m_tokens.begin() + first);
+    if (relexed.size() > reused) {
+        m_tokens.insert(m_tokens.begin() + first + reused, relexed.begin() + reused, relexed.end());
+    } else {
+        m_tokens.erase(m_tokens.begin() + first + reused, m_tokens.begin() + tail);
+    }
+
+    // Leave the stream where `tokenize` leaves it, at EOF
+    m_lookahead.clear();
+    m_lookahead.push_back(m_tokens.back());
+    m_reachedEOF = true;
+    m_pos = m_source.size();
+
+    return relexed.size();
+}
@@ -0,0 +1,205 @@
+#include "Lexer/ParallelLexer.hpp"
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/Token.hpp"
+#include "Diagnostics/Diagnostic.hpp"
+#include "Diagnostics/DiagnosticBuffer.hpp"
+#include "Utils/ParallelFor.hpp"
+
+namespace {
+    constexpr size_t NoBoundary = SIZE_MAX;
+}
+
+ParallelLexer::ParallelLexer(
+    ISourceManager::FileID fileID,
+    ISourceManager& sourceManager,
+    IDiagnosticEngine& diagnosticEngine,
+    size_t threadCount,
+    size_t minChunkSize
+)
+:   m_fileID(fileID),
+    m_sourceManager(sourceManager),
+    m_diagnosticEngine(diagnosticEngine),
+    m_source(sourceManager.getBuffer(fileID)),
+    m_threadCount(std::max<size_t>(threadCount, 1)),
+    m_minChunkSize(std::max<size_t>(minChunkSize, 1)) {}
+
+std::string_view ParallelLexer::getLexeme(const Token& token) const {
+    if (token.spelling != Token::NoSpelling) {
+        return m_spellings[token.spelling];
+    }
+    return m_source.substr(token.offset, token.length);
+}
+
+size_t ParallelLexer::findSafeBoundary(size_t from, size_t to) const {
+    enum class State { Code, String, Char, LineComment, BlockComment };
+
+    // Speculative: assumes `from` is outside of any literal or comment
+    State state = State::Code;
+    int depth = 0;
+
+    for (size_t i = from; i < to; ++i) {
+        const char c = m_source[i];
+        const char next = i + 1 < m_source.size() ? m_source[i + 1] : '\0';
+
+        switch (state) {
+            case State::Code:
+                if (c == '\n') {
+                    return i + 1;
+                } else if (c == '"') {
+                    state = State::String;
+                } else if (c == '\'' && next == '\'') {
+                    // Empty char literal
+                    i += 1;
+                } else if (c == '\'') {
+                    state = State::Char;
+                    // The codepoint right after the quote always belongs to the literal
+                    i += next == '\\' ? 1 : 0;
+                    i += 1;
+                } else if (c == '/' && next == '/') {
+                    state = State::LineComment;
+                    i += 1;
+                } else if (c == '/' && next == '*') {
+                    state = State::BlockComment;
+                    depth = 1;
+                    i += 1;
+                }
+                break;
+
+            case State::String:
+                if (c == '\\') {
+                    i += 1;
+                } else if (c == '"') {
+                    state = State::Code;
+                }
+                break;
+
+            case State::Char:
+                // Char literals never continue past the end of a line
+                if (c == '\'') {
+                    state = State::Code;
+                } else if (c == '\n') {
+                    return i + 1;
+                }
+                break;
+
+            case State::LineComment:
+                if (c == '\n') {
+                    return i + 1;
+                }
+                break;
+
+            case State::BlockComment:
+                if (c == '/' && next == '*') {
+                    depth += 1;
+                    i += 1;
+                } else if (c == '*' && next == '/') {
+                    depth -= 1;
+                    i += 1;
+                    if (depth == 0) {
+                        state = State::Code;
+                    }
+                }
+                break;
+        }
+    }
+
+    return NoBoundary;
+}
+
+std::vector<size_t> ParallelLexer::findBoundaries() const {
+    const size_t chunkCount = std::clamp<size_t>(m_source.size() / m_minChunkSize, 1, m_threadCount);
+
+    // Every chunk looks for its own start between its nominal offset and the next one
+    std::vector<size_t> candidates(chunkCount, NoBoundary);
+    parallelFor(chunkCount - 1, m_threadCount, [&](size_t i) {
+        const size_t chunk = i + 1;
+        const size_t from = m_source.size() * chunk / chunkCount;
+        const size_t to = m_source.size() * (chunk + 1) / chunkCount;
+        candidates[chunk] = findSafeBoundary(from, to);
+    });
+
+    // The first chunk always starts at the beginning, even for an empty buffer
+    std::vector<size_t> boundaries = { 0 };
+    for (size_t candidate : candidates) {
+        if (candidate == NoBoundary || candidate >= m_source.size() || candidate <= boundaries.back()) {
+            continue;
+        }
+        boundaries.push_back(candidate);
+    }
+    return boundaries;
+}
+
+void ParallelLexer::lexChunk(Chunk& chunk) {
+    Lexer lexer(m_fileID, m_sourceManager, chunk.diagnostics, chunk.start, chunk.end);
+    chunk.tokens = std::move(lexer.tokenize());
+    chunk.spellings = lexer.getSpellings();
+    chunk.stop = lexer.getOffset();
+}
+
+void ParallelLexer::appendChunk(Chunk& chunk, bool isLast) {
+    const uint32_t spellingBase = static_cast<uint32_t>(m_spellings.size());
+
+    for (Token& token : chunk.tokens) {
+        if (token.kind == TOK_EOF && !isLast) {
+            continue;
+        }
+        if (token.spelling != Token::NoSpelling) {
+            token.spelling += spellingBase;
+        }
+        m_tokens.push_back(token);
+    }
+
+    m_spellings.insert(
+        m_spellings.end(),
+        std::make_move_iterator(chunk.spellings.begin()),
+        std::make_move_iterator(chunk.spellings.end())
+    );
+}
+
+std::vector<Token>& ParallelLexer::tokenize() {
+    // Already complete, a second pass would append the stream and its diagnostics again
+    if (!m_tokens.empty() && m_tokens.back().kind == TOK_EOF) {
+        return m_tokens;
+    }
+
+    const std::vector<size_t> boundaries = findBoundaries();
+
+    std::vector<Chunk> chunks(boundaries.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].start = boundaries[i];
+        chunks[i].end = i + 1 < boundaries.size() ? boundaries[i + 1] : SIZE_MAX;
+        // A chunk with that many errors alone would abort the engine, so stop it early
+        chunks[i].diagnostics.setErrorLimit(m_diagnosticEngine.getErrorLimit());
+    }
+
+    parallelFor(chunks.size(), m_threadCount, [&](size_t i) {
+        lexChunk(chunks[i]);
+    });
+
+    // Stitch in order, validating each speculated start against where the previous chunk stopped
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        Chunk& chunk = chunks[i];
+
+        if (i > 0 && chunk.start != chunks[i - 1].stop) {
+            chunk.start = chunks[i - 1].stop;
+            chunk.diagnostics.clear();
+            lexChunk(chunk);
+            m_relexedChunkCount += 1;
+        }
+
+        chunk.diagnostics.flush(m_diagnosticEngine);
+        // Past the error limit the rest of the file is skipped, this chunk's EOF ends the stream
+        const bool isLast = i + 1 == chunks.size() || m_diagnosticEngine.shouldAbort();
+        appendChunk(chunk, isLast);
+        if (isLast) {
+            break;
+        }
+    }
+
+    return m_tokens;
+}
@@ -0,0 +1,108 @@
+#include "Lexer/StreamingLexer.hpp"
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/Token.hpp"
+#include "Diagnostics/Diagnostic.hpp"
+#include "Diagnostics/DiagnosticBuffer.hpp"
+
+StreamingLexer::StreamingLexer(
+    SourceManager::FileID fileID,
+    SourceManager& sourceManager,
+    IDiagnosticEngine& diagnosticEngine,
+    int fd,
+    size_t chunkSize
+)
+:   m_fileID(fileID),
+    m_sourceManager(sourceManager),
+    m_diagnosticEngine(diagnosticEngine),
+    m_fd(fd),
+    m_chunkSize(std::max<size_t>(chunkSize, 1)),
+    m_readSize(m_chunkSize) {}
+
+std::string_view StreamingLexer::getLexeme(const Token& token) const {
+    if (token.spelling != Token::NoSpelling) {
+        return m_spellings[token.spelling];
+    }
+    return m_sourceManager.getBuffer(m_fileID).substr(token.offset, token.length);
+}
+
+std::span<const Token> StreamingLexer::lexChunk() {
+    if (m_isDone) {
+        return {};
+    }
+
+    const size_t tokenCount = m_tokens.size();
+    std::optional<size_t> count = m_sourceManager.readStream(m_fileID, m_fd, m_readSize);
+    // A failed read ends the stream, whatever arrived is still lexed
+    lexAvailable(count.value_or(0) == 0);
+
+    // A token longer than a chunk would be relexed on every read, grow the reads until it fits
+    m_readSize = m_tokens.size() > tokenCount ? m_chunkSize : m_readSize * 2;
+
+    return std::span<const Token>(m_tokens).subspan(tokenCount);
+}
+
+std::vector<Token>& StreamingLexer::tokenize() {
+    while (!m_isDone) {
+        lexChunk();
+    }
+    return m_tokens;
+}
+
+void StreamingLexer::lexAvailable(bool isFinal) {
+    const size_t available = m_sourceManager.getBuffer(m_fileID).size();
+    if (!isFinal && available < m_committed + LookaheadMargin) {
+        return;
+    }
+
+    // A pass with that many errors alone would abort the engine, so the pass stops there too
+    DiagnosticBuffer diagnostics;
+    diagnostics.setErrorLimit(m_diagnosticEngine.getErrorLimit());
+    Lexer lexer(m_fileID, m_sourceManager, diagnostics, m_committed, SIZE_MAX);
+    const uint32_t spellingBase = static_cast<uint32_t>(m_spellings.size());
+    size_t spellingCount = 0;
+    size_t diagnosticCount = 0;
+
+    // Tokens come out in order, so the first one that is not final ends the pass
+    while (true) {
+        Token token = lexer.next();
+        const size_t end = static_cast<size_t>(token.offset) + token.length;
+        if (!isFinal && (token.kind == TOK_EOF || end + LookaheadMargin > available)) {
+            break;
+        }
+
+        if (token.spelling != Token::NoSpelling) {
+            spellingCount = token.spelling + 1;
+            token.spelling += spellingBase;
+        }
+        m_tokens.push_back(token);
+        m_committed = end;
+        // Everything reported so far belongs to this token or the trivia before it
+        diagnosticCount = diagnostics.getDiagnostics().size();
+
+        if (token.kind == TOK_EOF) {
+            m_isDone = true;
+            break;
+        }
+    }
+
+    const std::vector<std::string>& spellings = lexer.getSpellings();
+    m_spellings.insert(m_spellings.end(), spellings.begin(), spellings.begin() + spellingCount);
+
+    const std::vector<Diagnostic>& buffered = diagnostics.getDiagnostics();
+    for (size_t i = 0; i < diagnosticCount; ++i) {
+        m_diagnosticEngine.addDiagnostic(buffered[i]);
+    }
+
+    // Past the error limit the rest of the input is not read, the stream ends where it stopped
+    if (!m_isDone && m_diagnosticEngine.shouldAbort()) {
+        m_tokens.push_back(Token{ .kind = TOK_EOF, .offset = m_committed, .length = 0 });
+        m_isDone = true;
+    }
+}
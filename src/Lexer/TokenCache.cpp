@@ -0,0 +1,182 @@
+#include "Lexer/TokenCache.hpp"
+
+#include <span>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/Token.hpp"
+#include "Utils/Hash.hpp"
+#include "SourceManager/SourceBuffer.hpp"
+
+namespace {
+    constexpr char Magic[4] = { 'B', 'Z', 'T', 'K' };
+    constexpr uint32_t FormatVersion = 3; // 2: 64-bit token offsets, 3: offsets packed with the kind
+
+    // Followed by Token[tokenCount], uint32_t[spellingCount + 1] offsets and the spelling bytes
+    struct EntryHeader {
+        char magic[4];
+        uint32_t formatVersion;
+        uint32_t lexerVersion;
+        uint32_t tokenSize;
+        uint64_t hashLow;
+        uint64_t hashHigh;
+        uint64_t sourceSize;
+        uint64_t tokenCount;
+        uint64_t spellingCount;
+        uint64_t spellingBytes;
+    };
+    static_assert(sizeof(EntryHeader) % alignof(Token) == 0);
+    static_assert(sizeof(Token) % alignof(uint32_t) == 0);
+
+    size_t getEntrySize(const EntryHeader& header) {
+        return sizeof(EntryHeader)
+            + header.tokenCount * sizeof(Token)
+            + (header.spellingCount + 1) * sizeof(uint32_t)
+            + header.spellingBytes;
+    }
+}
+
+std::string_view CachedTokens::getLexeme(const Token& token) const {
+    if (token.spelling != Token::NoSpelling) {
+        const uint32_t begin = m_spellingOffsets[token.spelling];
+        return std::string_view(m_spellings + begin, m_spellingOffsets[token.spelling + 1] - begin);
+    }
+    return m_source.substr(token.offset, token.length);
+}
+
+TokenCache::TokenCache(std::filesystem::path directory) : m_directory(std::move(directory)) {}
+
+std::filesystem::path TokenCache::getEntryPath(const ContentHash& hash) const {
+    return m_directory / (hash.toString() + "-v" + std::to_string(Lexer::Version) + ".tokens");
+}
+
+std::optional<CachedTokens> TokenCache::load(const ContentHash& hash, std::string_view source) const {
+    std::optional<SourceBuffer> entry = SourceBuffer::fromFile(getEntryPath(hash).string(), SourceBuffer::Mode::Mapped);
+    if (!entry.has_value() || entry->size() < sizeof(EntryHeader)) {
+        return std::nullopt;
+    }
+
+    const char* data = entry->view().data();
+    EntryHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    const bool isCompatible = std::memcmp(header.magic, Magic, sizeof(Magic)) == 0
+        && header.formatVersion == FormatVersion
+        && header.lexerVersion == Lexer::Version
+        && header.tokenSize == sizeof(Token);
+    const bool isSameSource = header.hashLow == hash.low
+        && header.hashHigh == hash.high
+        && header.sourceSize == source.size();
+    // Counts are bounded before multiplying so a corrupt header cannot overflow the size check
+    const bool isSized = header.tokenCount <= entry->size() && header.spellingCount <= entry->size()
+        && header.spellingBytes <= entry->size() && getEntrySize(header) == entry->size();
+    if (!isCompatible || !isSameSource || !isSized || header.tokenCount == 0) {
+        return std::nullopt;
+    }
+
+    CachedTokens cached;
+    const char* cursor = data + sizeof(EntryHeader);
+    cached.m_tokens = std::span<const Token>(reinterpret_cast<const Token*>(cursor), header.tokenCount);
+    cursor += header.tokenCount * sizeof(Token);
+    cached.m_spellingOffsets = reinterpret_cast<const uint32_t*>(cursor);
+    cached.m_spellings = cursor + (header.spellingCount + 1) * sizeof(uint32_t);
+    cached.m_source = source;
+
+    // One pass keeps every later lexeme lookup in bounds, far cheaper than the lex it replaces
+    if (cached.m_spellingOffsets[0] != 0 || cached.m_spellingOffsets[header.spellingCount] != header.spellingBytes) {
+        return std::nullopt;
+    }
+    for (uint64_t i = 0; i < header.spellingCount; ++i) {
+        if (cached.m_spellingOffsets[i] > cached.m_spellingOffsets[i + 1]) {
+            return std::nullopt;
+        }
+    }
+    for (size_t i = 0; i < cached.m_tokens.size(); ++i) {
+        const Token& token = cached.m_tokens[i];
+        const bool isInSource = static_cast<uint64_t>(token.offset) + token.length <= source.size();
+        const bool isSpellingValid = token.spelling == Token::NoSpelling || token.spelling < header.spellingCount;
+        // Exactly one EOF, ending the stream, a doubled entry would otherwise pass
+        const bool isLast = i + 1 == cached.m_tokens.size();
+        if (!isInSource || !isSpellingValid || (token.kind == TOK_EOF) != isLast) {
+            return std::nullopt;
+        }
+    }
+
+    cached.m_entry = std::move(*entry);
+    return cached;
+}
+
+bool TokenCache::store(const ContentHash& hash, std::string_view source, std::span<const Token> tokens, const std::vector<std::string>& spellings) const {
+    EntryHeader header = {
+        .magic = { Magic[0], Magic[1], Magic[2], Magic[3] },
+        .formatVersion = FormatVersion,
+        .lexerVersion = Lexer::Version,
+        .tokenSize = sizeof(Token),
+        .hashLow = hash.low,
+        .hashHigh = hash.high,
+        .sourceSize = source.size(),
+        .tokenCount = tokens.size(),
+        .spellingCount = spellings.size(),
+        .spellingBytes = 0,
+    };
+    for (const std::string& spelling : spellings) {
+        header.spellingBytes += spelling.size();
+    }
+    if (header.spellingBytes > UINT32_MAX) {
+        return false;
+    }
+
+    // Built field by field into zeroed memory so padding bytes, and with them the entry, are deterministic
+    std::string entry(getEntrySize(header), '\0');
+    std::memcpy(entry.data(), &header, sizeof(header));
+    char* cursor = entry.data() + sizeof(EntryHeader);
+    for (const Token& token : tokens) {
+        Token* slot = reinterpret_cast<Token*>(cursor);
+        slot->kind = token.kind;
+        slot->offset = token.offset;
+        slot->length = token.length;
+        slot->spelling = token.spelling;
+        cursor += sizeof(Token);
+    }
+
+    uint32_t spellingOffset = 0;
+    char* spellingData = cursor + (spellings.size() + 1) * sizeof(uint32_t);
+    for (const std::string& spelling : spellings) {
+        std::memcpy(cursor, &spellingOffset, sizeof(spellingOffset));
+        std::memcpy(spellingData + spellingOffset, spelling.data(), spelling.size());
+        cursor += sizeof(uint32_t);
+        spellingOffset += static_cast<uint32_t>(spelling.size());
+    }
+    std::memcpy(cursor, &spellingOffset, sizeof(spellingOffset));
+
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+
+    const std::filesystem::path path = getEntryPath(hash);
+    std::filesystem::path temporary = path;
+    temporary += "." + std::to_string(std::random_device{}()) + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+        if (!file.flush()) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
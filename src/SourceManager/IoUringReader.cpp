@@ -0,0 +1,194 @@
+#include "SourceManager/IoUringReader.hpp"
+
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+#if defined(BLAZE_HAS_IO_URING)
+#include <cerrno>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+namespace {
+    // A single read is capped so `len` fits the 32-bit SQE field
+    constexpr size_t MaxReadSize = 1u << 30;
+
+    template <typename T>
+    T* ringField(void* ring, unsigned offset) {
+        return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+    }
+}
+
+IoUringReader::IoUringReader(unsigned entries) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    const int ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ringFd < 0) {
+        return;
+    }
+
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool isSingleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (isSingleMap) {
+        m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+    }
+
+    m_sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if (m_sqRing == MAP_FAILED) {
+        m_sqRing = nullptr;
+        close(ringFd);
+        return;
+    }
+
+    m_cqRing = isSingleMap
+        ? m_sqRing
+        : mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (m_cqRing == MAP_FAILED || m_sqes == MAP_FAILED) {
+        m_cqRing = m_cqRing == MAP_FAILED ? nullptr : m_cqRing;
+        m_sqes = m_sqes == MAP_FAILED ? nullptr : m_sqes;
+        m_ringFd = ringFd;
+        release();
+        return;
+    }
+
+    m_sqTail = ringField<unsigned>(m_sqRing, params.sq_off.tail);
+    m_sqMask = ringField<unsigned>(m_sqRing, params.sq_off.ring_mask);
+    m_sqArray = ringField<unsigned>(m_sqRing, params.sq_off.array);
+    m_cqHead = ringField<unsigned>(m_cqRing, params.cq_off.head);
+    m_cqTail = ringField<unsigned>(m_cqRing, params.cq_off.tail);
+    m_cqMask = ringField<unsigned>(m_cqRing, params.cq_off.ring_mask);
+    m_cqes = ringField<void>(m_cqRing, params.cq_off.cqes);
+
+    m_entries = params.sq_entries;
+    m_ringFd = ringFd;
+}
+
+IoUringReader::~IoUringReader() {
+    release();
+}
+
+void IoUringReader::release() {
+    if (m_sqes != nullptr) {
+        munmap(m_sqes, m_sqesSize);
+    }
+    if (m_cqRing != nullptr && m_cqRing != m_sqRing) {
+        munmap(m_cqRing, m_cqRingSize);
+    }
+    if (m_sqRing != nullptr) {
+        munmap(m_sqRing, m_sqRingSize);
+    }
+    if (m_ringFd >= 0) {
+        close(m_ringFd);
+    }
+    m_sqes = m_cqRing = m_sqRing = nullptr;
+    m_ringFd = -1;
+}
+
+bool IoUringReader::readAll(std::span<Request> requests) {
+    if (!isValid()) {
+        return false;
+    }
+
+    std::vector<size_t> pending;
+    pending.reserve(requests.size());
+    for (size_t i = requests.size(); i-- > 0;) {
+        if (requests[i].done < requests[i].size) {
+            pending.push_back(i);
+        }
+    }
+
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(m_sqes);
+    io_uring_cqe* cqes = static_cast<io_uring_cqe*>(m_cqes);
+    unsigned inFlight = 0;
+    // Queued in the ring but not yet consumed by the kernel, resubmitted by the next enter
+    unsigned unsubmitted = 0;
+
+    while (!pending.empty() || inFlight > 0 || unsubmitted > 0) {
+        // Queue as many reads as the ring has room for
+        unsigned tail = *m_sqTail;
+        unsigned queued = 0;
+        while (!pending.empty() && inFlight + unsubmitted + queued < m_entries) {
+            const size_t index = pending.back();
+            pending.pop_back();
+            Request& request = requests[index];
+
+            const unsigned slot = tail & *m_sqMask;
+            io_uring_sqe& sqe = sqes[slot];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = request.fd;
+            sqe.addr = reinterpret_cast<uint64_t>(request.data + request.done);
+            sqe.len = static_cast<uint32_t>(std::min(request.size - request.done, MaxReadSize));
+            sqe.off = request.done;
+            sqe.user_data = index;
+            m_sqArray[slot] = slot;
+            tail += 1;
+            queued += 1;
+        }
+        __atomic_store_n(m_sqTail, tail, __ATOMIC_RELEASE);
+
+        int result;
+        do {
+            result = static_cast<int>(syscall(__NR_io_uring_enter, m_ringFd, unsubmitted + queued, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+        } while (result < 0 && errno == EINTR);
+        if (result < 0) {
+            return false;
+        }
+        // The kernel may consume fewer SQEs than offered, the rest stay queued for the next enter
+        const unsigned consumed = static_cast<unsigned>(result);
+        unsubmitted = unsubmitted + queued - consumed;
+        inFlight += consumed;
+        if (consumed == 0 && inFlight == 0) {
+            // Nothing was taken and nothing will complete, waiting again would spin forever
+            return false;
+        }
+
+        // Reap completions, short reads go back on the pending list
+        unsigned head = *m_cqHead;
+        const unsigned cqTail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+        for (; head != cqTail; ++head) {
+            const io_uring_cqe& cqe = cqes[head & *m_cqMask];
+            Request& request = requests[cqe.user_data];
+            inFlight -= 1;
+
+            if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+                pending.push_back(cqe.user_data);
+            } else if (cqe.res < 0) {
+                request.failed = true;
+            } else if (cqe.res == 0) {
+                // The file shrank since it was sized, keep what was read
+                request.size = request.done;
+            } else {
+                request.done += static_cast<size_t>(cqe.res);
+                if (request.done < request.size) {
+                    pending.push_back(cqe.user_data);
+                }
+            }
+        }
+        __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    return true;
+}
+
+#else
+
+IoUringReader::IoUringReader(unsigned) {}
+
+IoUringReader::~IoUringReader() {}
+
+void IoUringReader::release() {}
+
+bool IoUringReader::readAll(std::span<Request>) {
+    return false;
+}
+
+#endif
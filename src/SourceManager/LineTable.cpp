@@ -0,0 +1,94 @@
+#include "SourceManager/LineTable.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+    void appendLineStarts(std::string_view buffer, std::vector<uint64_t>& lineStarts) {
+        const char* data = buffer.data();
+        const size_t size = buffer.size();
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        // Compare 16 bytes at a time and walk the set bits of the newline mask
+        const __m128i newline = _mm_set1_epi8('\n');
+        for (; i + 16 <= size; i += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)));
+            while (mask != 0) {
+                lineStarts.push_back(static_cast<uint64_t>(i + __builtin_ctz(mask) + 1));
+                mask &= mask - 1;
+            }
+        }
+#endif
+
+        for (; i < size; ++i) {
+            if (data[i] == '\n') {
+                lineStarts.push_back(static_cast<uint64_t>(i + 1));
+            }
+        }
+    }
+}
+
+LineTable::LineTable(std::string_view buffer) : m_buffer(buffer) {
+    m_lineStarts.reserve(buffer.size() / 32 + 1);
+    m_lineStarts.push_back(0);
+    appendLineStarts(buffer, m_lineStarts);
+}
+
+void LineTable::applyEdit(std::string_view buffer, size_t offset, size_t removedLength, size_t insertedLength) {
+    m_buffer = buffer;
+
+    // Line starts produced by newlines inside the removed bytes go away
+    auto first = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset);
+    auto last = std::upper_bound(first, m_lineStarts.end(), offset + removedLength);
+
+    // Everything after the edit moves by the size difference
+    const uint64_t delta = static_cast<uint64_t>(insertedLength - removedLength);
+    for (auto it = last; it != m_lineStarts.end(); ++it) {
+        *it += delta;
+    }
+
+    std::vector<uint64_t> inserted;
+    appendLineStarts(buffer.substr(offset, insertedLength), inserted);
+    for (uint64_t& lineStart : inserted) {
+        lineStart += offset;
+    }
+
+    // Reuse the slots of removed line starts before growing or shrinking the vector
+    const size_t removedCount = static_cast<size_t>(last - first);
+    const size_t reused = std::min(removedCount, inserted.size());
+    std::copy(inserted.begin(), inserted.begin() + reused, first);
+    if (inserted.size() > reused) {
+        m_lineStarts.insert(first + reused, inserted.begin() + reused, inserted.end());
+    } else {
+        m_lineStarts.erase(first + reused, last);
+    }
+}
+
+size_t LineTable::getLine(size_t offset) const {
+    // The last line start that is not past the offset
+    auto it = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset);
+    return static_cast<size_t>(it - m_lineStarts.begin());
+}
+
+std::pair<size_t, size_t> LineTable::getLineColumn(size_t offset) const {
+    const size_t line = getLine(offset);
+    const size_t lineStart = m_lineStarts[line - 1];
+    const size_t end = std::min(offset, m_buffer.size());
+
+    // Count codepoints by skipping UTF-8 continuation bytes
+    size_t column = 1;
+    for (size_t i = lineStart; i < end; ++i) {
+        if ((static_cast<uint8_t>(m_buffer[i]) & 0xC0) != 0x80) {
+            column += 1;
+        }
+    }
+
+    return { line, column };
+}
@@ -0,0 +1,77 @@
+#include "SourceManager/PathCache.hpp"
+
+#include <mutex>
+#include <string>
+#include <optional>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BLAZE_HAS_STAT 1
+#include <sys/stat.h>
+#endif
+
+std::optional<PathCache::FileIdentity> PathCache::statPath(const std::string& path) {
+#if defined(BLAZE_HAS_STAT)
+    struct stat status;
+    if (stat(path.c_str(), &status) != 0) {
+        return std::nullopt;
+    }
+
+#if defined(__APPLE__)
+    const timespec& modified = status.st_mtimespec;
+#else
+    const timespec& modified = status.st_mtim;
+#endif
+    return FileIdentity{
+        .device = static_cast<uint64_t>(status.st_dev),
+        .inode = static_cast<uint64_t>(status.st_ino),
+        .modifiedSeconds = static_cast<int64_t>(modified.tv_sec),
+        .modifiedNanoseconds = static_cast<int64_t>(modified.tv_nsec),
+    };
+#else
+    (void)path;
+    return std::nullopt;
+#endif
+}
+
+std::optional<std::string> PathCache::canonicalize(std::string_view path) {
+    // Relative paths depend on the working directory, so they are keyed by their absolute form.
+    // Not normalized, `link/..` must not fold to the same key as the directory holding `link`
+    std::error_code error;
+    const std::filesystem::path absolutePath = std::filesystem::absolute(path, error);
+    if (error) {
+        return std::nullopt;
+    }
+    const std::string key = absolutePath.string();
+
+#if defined(BLAZE_HAS_STAT)
+    // The stat doubles as the existence check, a missing path costs no more than it did uncached
+    const std::optional<FileIdentity> identity = statPath(key);
+    if (!identity.has_value()) {
+        return std::nullopt;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto& entryIt = m_entries.find(key);
+        if (entryIt != m_entries.end() && entryIt->second.identity == identity.value()) {
+            m_hitCount.fetch_add(1, std::memory_order_relaxed);
+            return entryIt->second.canonicalPath;
+        }
+    }
+#endif
+
+    m_missCount.fetch_add(1, std::memory_order_relaxed);
+    const std::filesystem::path canonicalPath = std::filesystem::canonical(absolutePath, error);
+    if (error) {
+        return std::nullopt;
+    }
+
+#if defined(BLAZE_HAS_STAT)
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.insert_or_assign(key, Entry{ .canonicalPath = canonicalPath.string(), .identity = identity.value() });
+#endif
+    return canonicalPath.string();
+}
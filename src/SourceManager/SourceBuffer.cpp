@@ -0,0 +1,317 @@
+#include "SourceManager/SourceBuffer.hpp"
+
+#include <memory>
+#include <string>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <optional>
+#include <string_view>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BLAZE_HAS_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+#if defined(BLAZE_HAS_MMAP)
+    // Maps the whole file read-only followed by at least Padding NUL bytes, returns nullptr when
+    // the file cannot be mapped. Only whole pages come from the file, the partial last page is
+    // read into a private zeroed page, so the padding stays NUL even if the file grows meanwhile.
+    const char* mapFile(int fd, size_t size, size_t& mappedSize) {
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t fileBytes = size / pageSize * pageSize;
+        const size_t tailBytes = size - fileBytes;
+        mappedSize = fileBytes + (tailBytes + SourceBuffer::Padding + pageSize - 1) / pageSize * pageSize;
+
+        // Reserve the address range without committing memory, multi-GB files must not count
+        // against the overcommit limit
+        void* address = mmap(nullptr, mappedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (address == MAP_FAILED) {
+            return nullptr;
+        }
+        char* data = static_cast<char*>(address);
+
+        if (fileBytes > 0) {
+            if (mmap(data, fileBytes, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+                munmap(data, mappedSize);
+                return nullptr;
+            }
+            // The lexer walks the buffer front to back
+            madvise(data, fileBytes, MADV_SEQUENTIAL);
+        }
+
+        char* tail = data + fileBytes;
+        const size_t tailSize = mappedSize - fileBytes;
+        if (mmap(tail, tailSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED
+            || SourceBuffer::readFully(fd, tail, tailBytes, fileBytes) != tailBytes) {
+            munmap(data, mappedSize);
+            return nullptr;
+        }
+        mprotect(tail, tailSize, PROT_READ);
+        return data;
+    }
+#endif
+
+    // Room for `capacity` bytes and the padding after them
+    std::unique_ptr<char[]> allocate(size_t capacity) {
+        return std::make_unique_for_overwrite<char[]>(capacity + SourceBuffer::Padding);
+    }
+}
+
+SourceBuffer::~SourceBuffer() {
+    release();
+}
+
+SourceBuffer::SourceBuffer(SourceBuffer&& other) noexcept
+:   m_data(std::exchange(other.m_data, EmptyPadding)),
+    m_size(std::exchange(other.m_size, 0)),
+    m_isMapped(std::exchange(other.m_isMapped, false)),
+    m_mappedSize(std::exchange(other.m_mappedSize, 0)),
+    m_capacity(std::exchange(other.m_capacity, 0)),
+    m_storage(std::move(other.m_storage)) {}
+
+SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_data = std::exchange(other.m_data, EmptyPadding);
+        m_size = std::exchange(other.m_size, 0);
+        m_isMapped = std::exchange(other.m_isMapped, false);
+        m_mappedSize = std::exchange(other.m_mappedSize, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+        m_storage = std::move(other.m_storage);
+    }
+    return *this;
+}
+
+void SourceBuffer::release() {
+#if defined(BLAZE_HAS_MMAP)
+    if (m_isMapped) {
+        munmap(const_cast<char*>(m_data), m_mappedSize);
+    }
+#endif
+    m_storage.reset();
+    m_data = EmptyPadding;
+    m_size = 0;
+    m_isMapped = false;
+    m_mappedSize = 0;
+    m_capacity = 0;
+}
+
+void SourceBuffer::replace(size_t offset, size_t length, std::string_view text) {
+    const size_t tailOffset = offset + length;
+    const size_t tailSize = m_size - tailOffset;
+    const size_t newSize = m_size - length + text.size();
+
+    // An empty buffer owns no storage and points at the shared padding, staying empty keeps it so
+    if (m_storage == nullptr && !m_isMapped && newSize == 0) {
+        return;
+    }
+
+    if (m_isMapped || newSize > m_capacity) {
+        // Leave room for further edits so keystrokes do not reallocate every time
+        const size_t capacity = newSize + newSize / 4 + 64;
+        std::unique_ptr<char[]> storage = allocate(capacity);
+        std::memcpy(storage.get(), m_data, offset);
+        std::memcpy(storage.get() + offset, text.data(), text.size());
+        std::memcpy(storage.get() + offset + text.size(), m_data + tailOffset, tailSize);
+
+        release();
+        m_storage = std::move(storage);
+        m_capacity = capacity;
+    } else {
+        std::memmove(m_storage.get() + offset + text.size(), m_storage.get() + tailOffset, tailSize);
+        std::memcpy(m_storage.get() + offset, text.data(), text.size());
+    }
+
+    m_data = m_storage.get();
+    m_size = newSize;
+    terminate();
+}
+
+void SourceBuffer::evict(size_t begin, size_t end) {
+#if defined(BLAZE_HAS_MMAP)
+    if (!m_isMapped) {
+        return;
+    }
+
+    // Only whole pages backed by the file, they fault back in from it if touched again. The
+    // private tail page holding the padding has no file behind it and is never dropped.
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t first = (begin + pageSize - 1) / pageSize * pageSize;
+    const size_t last = std::min(end, m_size) / pageSize * pageSize;
+    if (first < last) {
+        madvise(const_cast<char*>(m_data) + first, last - first, MADV_DONTNEED);
+    }
+#else
+    (void)begin;
+    (void)end;
+#endif
+}
+
+void SourceBuffer::terminate() {
+    std::memset(m_storage.get() + m_size, 0, Padding);
+}
+
+SourceBuffer SourceBuffer::fromBytes(std::string_view bytes) {
+    SourceBuffer buffer;
+    if (!bytes.empty()) {
+        buffer.m_storage = allocate(bytes.size());
+        std::memcpy(buffer.m_storage.get(), bytes.data(), bytes.size());
+        buffer.m_data = buffer.m_storage.get();
+        buffer.m_size = bytes.size();
+        buffer.m_capacity = bytes.size();
+        buffer.terminate();
+    }
+    return buffer;
+}
+
+void SourceBuffer::grow(size_t capacity) {
+    std::unique_ptr<char[]> storage = allocate(capacity);
+    std::memcpy(storage.get(), m_data, m_size);
+
+    const size_t size = m_size;
+    release();
+    m_storage = std::move(storage);
+    m_data = m_storage.get();
+    m_size = size;
+    m_capacity = capacity;
+    terminate();
+}
+
+std::optional<size_t> SourceBuffer::readAppend(int fd, size_t maxBytes) {
+    if (m_isMapped || m_capacity - m_size < maxBytes) {
+        grow(std::max(m_capacity * 2, m_size + maxBytes));
+    }
+
+#if defined(BLAZE_HAS_MMAP)
+    ssize_t count;
+    do {
+        count = read(fd, m_storage.get() + m_size, maxBytes);
+    } while (count < 0 && errno == EINTR);
+    if (count < 0) {
+        return std::nullopt;
+    }
+    m_size += static_cast<size_t>(count);
+    terminate();
+    return static_cast<size_t>(count);
+#else
+    (void)fd;
+    return std::nullopt;
+#endif
+}
+
+std::optional<SourceBuffer> SourceBuffer::prepare(const std::string& path, Mode mode, int& fd) {
+    SourceBuffer buffer;
+    fd = -1;
+
+#if defined(BLAZE_HAS_MMAP)
+    const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) {
+        return std::nullopt;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || !S_ISREG(status.st_mode)) {
+        close(file);
+        return std::nullopt;
+    }
+    const size_t size = static_cast<size_t>(status.st_size);
+
+    // Empty files cannot be mapped, they simply keep the empty default buffer
+    if (size == 0) {
+        close(file);
+        return buffer;
+    }
+
+    const bool shouldMap = mode == Mode::Mapped || mode == Mode::Windowed || (mode == Mode::Auto && size >= MapThreshold);
+    if (shouldMap) {
+        if (const char* mapped = mapFile(file, size, buffer.m_mappedSize)) {
+            close(file);
+            buffer.m_data = mapped;
+            buffer.m_size = size;
+            buffer.m_isMapped = true;
+            return buffer;
+        }
+    }
+
+    // Single allocation of the exact size plus padding, the caller reads straight into it
+    buffer.m_storage = allocate(size);
+    buffer.m_data = buffer.m_storage.get();
+    buffer.m_size = size;
+    buffer.m_capacity = size;
+    buffer.terminate();
+    fd = file;
+#else
+    (void)mode;
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return std::nullopt;
+    }
+
+    std::fseek(file, 0, SEEK_END);
+    const long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (size > 0) {
+        buffer.m_storage = allocate(static_cast<size_t>(size));
+        buffer.m_data = buffer.m_storage.get();
+        buffer.m_size = std::fread(buffer.m_storage.get(), 1, static_cast<size_t>(size), file);
+        buffer.m_capacity = static_cast<size_t>(size);
+        buffer.terminate();
+    }
+    std::fclose(file);
+#endif
+
+    return buffer;
+}
+
+void SourceBuffer::finishFill(size_t bytesRead) {
+    // A file that shrank between fstat and the read keeps only what was read
+    m_size = std::min(bytesRead, m_size);
+    terminate();
+}
+
+size_t SourceBuffer::readFully(int fd, char* data, size_t size, size_t offset) {
+    size_t total = 0;
+#if defined(BLAZE_HAS_MMAP)
+    while (total < size) {
+        const ssize_t count = pread(fd, data + total, size - total, static_cast<off_t>(offset + total));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(count);
+    }
+#else
+    (void)fd;
+    (void)data;
+    (void)size;
+    (void)offset;
+#endif
+    return total;
+}
+
+void SourceBuffer::closeFile(int fd) {
+#if defined(BLAZE_HAS_MMAP)
+    close(fd);
+#else
+    (void)fd;
+#endif
+}
+
+std::optional<SourceBuffer> SourceBuffer::fromFile(const std::string& path, Mode mode) {
+    int fd = -1;
+    std::optional<SourceBuffer> buffer = prepare(path, mode, fd);
+    if (buffer.has_value() && fd >= 0) {
+        buffer->finishFill(readFully(fd, buffer->fillData(), buffer->size()));
+        closeFile(fd);
+    }
+    return buffer;
+}
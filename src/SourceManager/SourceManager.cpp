@@ -1,44 +1,237 @@
 #include "SourceManager/SourceManager.hpp"
 
-#include <fstream>
-#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
 #include <optional>
+#include <algorithm>
+#include <stdexcept>
 #include <filesystem>
-#include <sstream>
 #include <string_view>
+#include <system_error>
+#include <unordered_map>
+
+#include "SourceManager/IoUringReader.hpp"
+#include "Utils/Hash.hpp"
+#include "Utils/ParallelFor.hpp"
+
+namespace {
+    // Indexes a window at a time and lets each window go before scanning the next one, so
+    // loading a windowed file never needs more than a window of it resident
+    LineTable indexWindowed(SourceBuffer& buffer) {
+        LineTable lineTable{ std::string_view() };
+        for (size_t offset = 0; offset < buffer.size(); offset += SourceBuffer::WindowSize) {
+            const size_t length = std::min(SourceBuffer::WindowSize, buffer.size() - offset);
+            lineTable.applyEdit(buffer.view(), offset, 0, length);
+            buffer.evict(offset, offset + length);
+        }
+        return lineTable;
+    }
+}
+
+std::string SourceManager::getOverlayPath(std::string_view path) {
+    std::error_code error;
+    std::filesystem::path absolutePath = std::filesystem::absolute(path, error);
+    return error ? std::string(path) : absolutePath.lexically_normal().string();
+}
+
+bool SourceManager::addOverlay(std::string_view path, std::string contents) {
+    std::string overlayPath = getOverlayPath(path);
+    if (m_pathToID.contains(overlayPath)) {
+        return false;
+    }
+    m_overlays[std::move(overlayPath)] = std::move(contents);
+    return true;
+}
 
 std::optional<ISourceManager::FileID> SourceManager::loadFile(const std::string_view path) {
-    if (!std::filesystem::exists(path)) {
+    // A path loaded before keeps its FileID, whether it came from an overlay or the disk
+    const std::string overlayPath = getOverlayPath(path);
+    if (const auto& pathToIDIt = m_pathToID.find(overlayPath); pathToIDIt != m_pathToID.end()) {
+        return pathToIDIt->second;
+    }
+
+    // Overlays shadow the disk
+    const auto& overlayIt = m_overlays.find(overlayPath);
+    if (overlayIt != m_overlays.end()) {
+        SourceBuffer buffer = SourceBuffer::fromBytes(overlayIt->second);
+        m_overlays.erase(overlayIt);
+
+        LineTable lineTable(buffer.view());
+        ContentHash hash = hash::hashBytes(buffer.view());
+        return addFile(overlayPath, std::move(buffer), std::move(lineTable), hash);
+    }
+
+    std::optional<std::string> canonicalPath = m_pathCache->canonicalize(path);
+    if (!canonicalPath.has_value()) {
         return std::nullopt;
     }
-    std::filesystem::path canonicalPath = std::filesystem::canonical(path);
 
-    const auto& pathToIDIt = m_pathToID.find(canonicalPath.string());
+    const auto& pathToIDIt = m_pathToID.find(canonicalPath.value());
     if (pathToIDIt != m_pathToID.end()) {
         return pathToIDIt->second;
     }
 
-    std::ifstream file(canonicalPath, std::ios::binary);
-    if (!file) {
+    // Mapped or read into a single allocation, the buffer is never copied after this
+    std::optional<SourceBuffer> buffer = SourceBuffer::fromFile(canonicalPath.value(), m_bufferMode);
+    if (!buffer.has_value()) {
         return std::nullopt;
     }
 
-    std::stringstream sourceBuffer;
-    sourceBuffer << file.rdbuf();
+    // Windowed files are too large to fingerprint eagerly, getContentHash still works on demand
+    if (m_bufferMode == SourceBuffer::Mode::Windowed) {
+        LineTable lineTable = indexWindowed(buffer.value());
+        return addFile(std::move(canonicalPath.value()), std::move(buffer.value()), std::move(lineTable), std::nullopt);
+    }
 
-    SourceManager::SourceFile sourceFile = { .path = canonicalPath.string(), .source = sourceBuffer.str() };
-    // Find the sources size before push back to sourceFile for index
-    ISourceManager::FileID fileID = m_sources.size();
+    // The buffer's bytes never move, so the line index and fingerprint can be built before it is stored
+    LineTable lineTable(buffer->view());
+    ContentHash hash = hash::hashBytes(buffer->view());
+    return addFile(std::move(canonicalPath.value()), std::move(buffer.value()), std::move(lineTable), hash);
+}
 
-    m_sources.push_back(sourceFile);
-    m_pathToID[canonicalPath.string()] = fileID;
+ISourceManager::FileID SourceManager::addFile(std::string path, SourceBuffer buffer, LineTable lineTable, std::optional<ContentHash> hash) {
+    const ISourceManager::FileID fileID = m_sources.size();
+    m_pathToID[path] = fileID;
 
+    // Content without a fingerprint is neither shared nor registered for later files to share
+    if (!hash.has_value()) {
+        m_sources.push_back({ .path = std::move(path), .content = m_contents.size() });
+        m_contents.push_back({ .buffer = std::move(buffer), .lineTable = std::move(lineTable), .hash = std::nullopt });
+        return fileID;
+    }
+
+    // Identical bytes under another path reuse the existing content, the new buffer is released here
+    if (m_shareIdenticalBuffers) {
+        const auto& hashToContentIt = m_hashToContent.find(*hash);
+        if (hashToContentIt != m_hashToContent.end() && m_contents[hashToContentIt->second].buffer.view() == buffer.view()) {
+            m_contents[hashToContentIt->second].fileCount += 1;
+            m_sources.push_back({ .path = std::move(path), .content = hashToContentIt->second });
+            return fileID;
+        }
+    }
+
+    m_hashToContent.emplace(*hash, m_contents.size());
+    m_sources.push_back({ .path = std::move(path), .content = m_contents.size() });
+    m_contents.push_back({ .buffer = std::move(buffer), .lineTable = std::move(lineTable), .hash = hash });
     return fileID;
 }
 
+std::vector<std::optional<ISourceManager::FileID>> SourceManager::loadFiles(std::span<const std::string> paths, BatchLoadOptions options) {
+    struct PendingFile {
+        std::string canonicalPath;
+        bool isInMemory = false; // An overlay or a path loaded before, resolved by loadFile
+        std::optional<SourceBuffer> buffer;
+        LineTable lineTable;
+        std::optional<ContentHash> hash;
+        int fd = -1;
+    };
+    std::vector<PendingFile> files(paths.size());
+
+    // Canonicalization is several syscalls per path on a cache miss, run it on the pool
+    parallelFor(paths.size(), options.threadCount, [&](size_t i) {
+        const std::string overlayPath = getOverlayPath(paths[i]);
+        if (m_overlays.contains(overlayPath) || m_pathToID.contains(overlayPath)) {
+            files[i].isInMemory = true;
+            return;
+        }
+
+        files[i].canonicalPath = m_pathCache->canonicalize(paths[i]).value_or(std::string());
+    });
+
+    // Only the first occurrence of a path that is not loaded yet does any I/O
+    std::vector<size_t> toLoad;
+    std::unordered_map<std::string_view, size_t> firstIndex;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const std::string& canonicalPath = files[i].canonicalPath;
+        if (canonicalPath.empty() || m_pathToID.contains(canonicalPath)) {
+            continue;
+        }
+        if (firstIndex.emplace(canonicalPath, i).second) {
+            toLoad.push_back(i);
+        }
+    }
+
+    // Open, stat and map, or allocate for a read
+    parallelFor(toLoad.size(), options.threadCount, [&](size_t k) {
+        PendingFile& file = files[toLoad[k]];
+        file.buffer = SourceBuffer::prepare(file.canonicalPath, m_bufferMode, file.fd);
+    });
+
+    // Fill the allocated buffers, as one io_uring batch when possible
+    std::vector<size_t> reads;
+    std::vector<IoUringReader::Request> requests;
+    for (size_t i : toLoad) {
+        if (files[i].fd >= 0) {
+            reads.push_back(i);
+            requests.push_back({ .fd = files[i].fd, .data = files[i].buffer->fillData(), .size = files[i].buffer->size() });
+        }
+    }
+
+    bool isRead = false;
+    if (options.useIoUring && !requests.empty()) {
+        IoUringReader reader;
+        isRead = reader.readAll(requests);
+    }
+
+    parallelFor(reads.size(), options.threadCount, [&](size_t k) {
+        PendingFile& file = files[reads[k]];
+        IoUringReader::Request& request = requests[k];
+        if (!isRead) {
+            // The ring may have failed requests before giving up, only the plain read counts. As
+            // in `SourceBuffer::load`, a short read keeps what was read
+            request.done = SourceBuffer::readFully(request.fd, request.data, request.size);
+            request.failed = false;
+        }
+        SourceBuffer::closeFile(request.fd);
+
+        if (request.failed) {
+            file.buffer.reset();
+        } else {
+            file.buffer->finishFill(request.done);
+        }
+    });
+
+    // Line tables and fingerprints only depend on their own buffer
+    parallelFor(toLoad.size(), options.threadCount, [&](size_t k) {
+        PendingFile& file = files[toLoad[k]];
+        if (!file.buffer.has_value()) {
+            return;
+        }
+        if (m_bufferMode == SourceBuffer::Mode::Windowed) {
+            file.lineTable = indexWindowed(file.buffer.value());
+        } else {
+            file.lineTable = LineTable(file.buffer->view());
+            file.hash = hash::hashBytes(file.buffer->view());
+        }
+    });
+
+    // Assign FileIDs serially in input order, duplicates resolve to the first occurrence
+    std::vector<std::optional<FileID>> fileIDs(paths.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        PendingFile& file = files[i];
+        if (file.isInMemory) {
+            fileIDs[i] = loadFile(paths[i]);
+            continue;
+        }
+        if (file.canonicalPath.empty()) {
+            continue;
+        }
+
+        const auto& pathToIDIt = m_pathToID.find(file.canonicalPath);
+        if (pathToIDIt != m_pathToID.end()) {
+            fileIDs[i] = pathToIDIt->second;
+        } else if (file.buffer.has_value()) {
+            fileIDs[i] = addFile(std::move(file.canonicalPath), std::move(file.buffer.value()), std::move(file.lineTable), file.hash);
+        }
+    }
+
+    return fileIDs;
+}
+
 std::string_view SourceManager::getBuffer(FileID fileID) const {
     const SourceManager::SourceFile& sourceFile = m_sources.at(fileID);
-    return std::string_view(sourceFile.source);
+    return m_contents[sourceFile.content].buffer.view();
 }
 
 std::string_view SourceManager::getPath(FileID fileID) const {
@@ -46,7 +239,83 @@ std::string_view SourceManager::getPath(FileID fileID) const {
     return std::string_view(source.path);
 }
 
+const LineTable& SourceManager::getLineTable(FileID fileID) const {
+    const SourceManager::SourceFile& source = m_sources.at(fileID);
+    return m_contents[source.content].lineTable;
+}
+
+ContentHash SourceManager::getContentHash(FileID fileID) const {
+    const SourceManager::SourceFile& source = m_sources.at(fileID);
+    const SourceContent& content = m_contents[source.content];
+    if (!content.hash.has_value()) {
+        content.hash = hash::hashBytes(content.buffer.view());
+    }
+    return content.hash.value();
+}
+
+SourceEdit SourceManager::applyEdit(FileID fileID, SourceRange range, std::string_view text) {
+    SourceManager::SourceFile& source = m_sources.at(fileID);
+    const size_t size = m_contents[source.content].buffer.size();
+    if (range.offset > size || range.length > size - range.offset) {
+        throw std::out_of_range("Edit range is outside of the source buffer");
+    }
+
+    // Copy on write, other files sharing these bytes must not observe the edit
+    if (m_contents[source.content].fileCount > 1) {
+        SourceContent& shared = m_contents[source.content];
+        shared.fileCount -= 1;
+
+        SourceBuffer copy;
+        copy.replace(0, 0, shared.buffer.view());
+        LineTable lineTable(copy.view());
+        m_contents.push_back({ .buffer = std::move(copy), .lineTable = std::move(lineTable), .hash = std::nullopt });
+        source.content = m_contents.size() - 1;
+    }
+
+    SourceContent& content = m_contents[source.content];
+
+    // The edited bytes no longer match the fingerprint this content was registered under
+    if (content.hash.has_value()) {
+        const auto& hashToContentIt = m_hashToContent.find(content.hash.value());
+        if (hashToContentIt != m_hashToContent.end() && hashToContentIt->second == source.content) {
+            m_hashToContent.erase(hashToContentIt);
+        }
+        content.hash.reset();
+    }
+
+    content.buffer.replace(range.offset, range.length, text);
+    content.lineTable.applyEdit(content.buffer.view(), range.offset, range.length, text.size());
+
+    return { .offset = range.offset, .removedLength = range.length, .insertedLength = text.size() };
+}
+
+void SourceManager::evict(FileID fileID, size_t begin, size_t end) {
+    m_contents[m_sources.at(fileID).content].buffer.evict(begin, end);
+}
+
+ISourceManager::FileID SourceManager::openStream(std::string name) {
+    const ISourceManager::FileID fileID = m_sources.size();
+    m_sources.push_back({ .path = std::move(name), .content = m_contents.size() });
+    m_contents.push_back({ .buffer = SourceBuffer(), .lineTable = LineTable(std::string_view()), .hash = std::nullopt });
+    return fileID;
+}
+
+std::optional<size_t> SourceManager::readStream(FileID fileID, int fd, size_t maxBytes) {
+    SourceContent& content = m_contents[m_sources.at(fileID).content];
+    const size_t offset = content.buffer.size();
+
+    std::optional<size_t> count = content.buffer.readAppend(fd, maxBytes);
+    if (count.value_or(0) > 0) {
+        content.lineTable.applyEdit(content.buffer.view(), offset, 0, count.value());
+        content.hash.reset();
+    }
+    return count;
+}
+
 SourceManager::~SourceManager() {
     m_sources.clear();
+    m_contents.clear();
     m_pathToID.clear();
+    m_overlays.clear();
+    m_hashToContent.clear();
 }
@@ -0,0 +1,42 @@
+#include "Utils/Arena.hpp"
+
+#include <memory>
+#include <cstring>
+#include <algorithm>
+#include <string_view>
+
+void* Arena::allocateSlow(size_t size, size_t alignment) {
+    // Requests larger than a block get a block of their own, the current one stays in use
+    const size_t required = size + alignment - 1;
+    if (required > m_nextBlockSize && m_cursor != nullptr) {
+        m_blocks.insert(m_blocks.end() - 1, std::make_unique_for_overwrite<char[]>(required));
+        m_capacity += required;
+        const uintptr_t block = reinterpret_cast<uintptr_t>(m_blocks[m_blocks.size() - 2].get());
+        return reinterpret_cast<void*>((block + alignment - 1) & ~(alignment - 1));
+    }
+
+    const size_t blockSize = std::max(m_nextBlockSize, required);
+    m_blocks.push_back(std::make_unique_for_overwrite<char[]>(blockSize));
+    m_capacity += blockSize;
+    m_cursor = m_blocks.back().get();
+    m_end = m_cursor + blockSize;
+    m_nextBlockSize = std::min(m_nextBlockSize * 2, MaxBlockSize);
+    return allocate(size, alignment);
+}
+
+std::string_view Arena::copyString(std::string_view text) {
+    if (text.empty()) {
+        return {};
+    }
+    char* data = static_cast<char*>(allocate(text.size(), 1));
+    std::memcpy(data, text.data(), text.size());
+    return std::string_view(data, text.size());
+}
+
+void Arena::reset() {
+    m_blocks.clear();
+    m_cursor = nullptr;
+    m_end = nullptr;
+    m_nextBlockSize = InitialBlockSize;
+    m_capacity = 0;
+}
@@ -0,0 +1,68 @@
+#include "Utils/Hash.hpp"
+
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace {
+    constexpr uint64_t P0 = 0xa0761d6478bd642full;
+    constexpr uint64_t P1 = 0xe7037ed1a0b428dbull;
+    constexpr uint64_t P2 = 0x8ebc6af09c88c6e3ull;
+    constexpr uint64_t P3 = 0x589965cc75374cc3ull;
+    constexpr uint64_t P4 = 0x1d8e4e27c47d124full;
+
+    constexpr size_t StripeSize = 32;
+
+    inline uint64_t read64(const char* p) {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    // Full 128-bit product folded back to 64 bits
+    inline uint64_t mix(uint64_t a, uint64_t b) {
+        const __uint128_t product = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+    }
+
+    inline void consumeStripe(const char* p, uint64_t& lane0, uint64_t& lane1) {
+        lane0 = mix(read64(p) ^ P1, read64(p + 8) ^ lane0);
+        lane1 = mix(read64(p + 16) ^ P2, read64(p + 24) ^ lane1);
+    }
+}
+
+std::string ContentHash::toString() const {
+    static constexpr char digits[] = "0123456789abcdef";
+    std::string result(32, '0');
+    for (int i = 0; i < 16; ++i) {
+        result[15 - i] = digits[(high >> (i * 4)) & 0xF];
+        result[31 - i] = digits[(low >> (i * 4)) & 0xF];
+    }
+    return result;
+}
+
+ContentHash hash::hashBytes(std::string_view bytes, uint64_t seed) {
+    const char* p = bytes.data();
+    size_t remaining = bytes.size();
+
+    uint64_t lane0 = seed ^ P0;
+    uint64_t lane1 = seed ^ P3;
+
+    for (; remaining >= StripeSize; remaining -= StripeSize, p += StripeSize) {
+        consumeStripe(p, lane0, lane1);
+    }
+
+    // The tail is zero padded, the length folded into the finalizer tells paddings apart
+    if (remaining > 0) {
+        char tail[StripeSize] = {};
+        std::memcpy(tail, p, remaining);
+        consumeStripe(tail, lane0, lane1);
+    }
+
+    const uint64_t length = static_cast<uint64_t>(bytes.size());
+    ContentHash result;
+    result.low = mix(lane0 ^ P4, lane1 ^ length ^ P1);
+    result.high = mix(lane1 ^ P2 ^ result.low, lane0 ^ length ^ P3);
+    return result;
+}
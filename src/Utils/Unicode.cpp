@@ -0,0 +1,7 @@
+#include "Utils/Unicode.hpp"
+
+#include <cstdint>
+
+namespace unicode {
+    #include "Utils/UnicodeTables.inc"
+}
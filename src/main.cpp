@@ -1,40 +1,261 @@
+#include <span>
+#include <cstdio>
+#include <charconv>
+#include <system_error>
+#include <format>
+#include <string>
+#include <vector>
 #include <optional>
 #include <iostream>
 #include <filesystem>
+#include <iterator>
+#include <algorithm>
+#include <string_view>
 
 #include "Lexer/Lexer.hpp"
+#include "Lexer/ParallelLexer.hpp"
+#include "Lexer/TokenCache.hpp"
+#include "Lexer/StreamingLexer.hpp"
 #include "Lexer/Token.hpp"
 #include "SourceManager/SourceManager.hpp"
+#include "Diagnostics/Diagnostic.hpp"
 #include "Diagnostics/DiagnosticEngine.hpp"
+#include "Diagnostics/DiagnosticExporter.hpp"
+
+constexpr std::string_view StdinPath = "-";
+
+struct DriverOptions {
+    std::vector<std::string> inputPaths;
+    size_t lexJobs = 1;
+    std::optional<std::string> tokenCacheDirectory;
+    std::optional<std::string> stdinOverlayPath;
+    bool isWindowed = false;
+    size_t errorLimit = IDiagnosticEngine::NoErrorLimit;
+    std::optional<DiagnosticExporter::Format> diagnosticFormat; // Colored text when unset
+    std::optional<std::string> diagnosticOutputPath;
+};
+
+// Whole argument as a decimal count, nullopt for anything else including out of range values
+static std::optional<size_t> parseCount(std::string_view arg) {
+    size_t value = 0;
+    const auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (error != std::errc() || end != arg.data() + arg.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+static std::optional<DriverOptions> parseOptions(int argc, char** argv) {
+    DriverOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if ((arg == "-j" || arg == "--lex-jobs") && i + 1 < argc) {
+            std::optional<size_t> lexJobs = parseCount(argv[++i]);
+            if (!lexJobs.has_value()) {
+                return std::nullopt;
+            }
+            options.lexJobs = std::max<size_t>(*lexJobs, 1);
+        } else if (arg == "--token-cache" && i + 1 < argc) {
+            options.tokenCacheDirectory = argv[++i];
+        } else if (arg == "--overlay" && i + 1 < argc) {
+            options.stdinOverlayPath = argv[++i];
+        } else if (arg == "--windowed") {
+            options.isWindowed = true;
+        } else if (arg == "--error-limit" && i + 1 < argc) {
+            std::optional<size_t> errorLimit = parseCount(argv[++i]);
+            if (!errorLimit.has_value()) {
+                return std::nullopt;
+            }
+            options.errorLimit = *errorLimit;
+        } else if (arg == "--diagnostic-format" && i + 1 < argc) {
+            std::string_view format = argv[++i];
+            if (format == "jsonl") {
+                options.diagnosticFormat = DiagnosticExporter::Format::JsonLines;
+            } else if (format == "sarif") {
+                options.diagnosticFormat = DiagnosticExporter::Format::Sarif;
+            } else if (format != "text") {
+                return std::nullopt;
+            }
+        } else if (arg == "--diagnostic-output" && i + 1 < argc) {
+            options.diagnosticOutputPath = argv[++i];
+        } else {
+            options.inputPaths.emplace_back(arg);
+        }
+    }
+
+    if (options.inputPaths.empty()) {
+        return std::nullopt;
+    }
+    return options;
+}
+
+template <typename TLexer>
+static void printTokens(const TLexer& lexer, std::span<const Token> tokens) {
+    for (const auto& token : tokens) {
+        std::cout << std::format("Token: {}", TokenKindToString(token.kind, lexer.getLexeme(token))) << '\n';
+    }
+}
+
+template <typename TLexer>
+static void printTokens(TLexer& lexer) {
+    printTokens(lexer, lexer.tokenize());
+}
+
+template <typename TLexer>
+static void lexFile(TLexer& lexer, const std::optional<TokenCache>& tokenCache, const ContentHash& hash, std::string_view source, const DiagnosticEngine& diagnosticEngine) {
+    const size_t diagnosticCount = diagnosticEngine.getDiagnosticCount();
+    const std::vector<Token>& tokens = lexer.tokenize();
+    printTokens(lexer, tokens);
+
+    // Streams that produced diagnostics are not cached, a hit would silently drop them
+    if (tokenCache.has_value() && diagnosticEngine.getDiagnosticCount() == diagnosticCount) {
+        tokenCache->store(hash, source, tokens, lexer.getSpellings());
+    }
+}
+
+// Prints tokens as they are lexed without collecting them, and releases the pages the lexer has
+// left a window behind, so files of many GB are lexed with bounded memory
+static void lexWindowed(Lexer& lexer, SourceManager& sourceManager, ISourceManager::FileID fileID) {
+    size_t evicted = 0;
+    while (true) {
+        const Token token = lexer.next();
+        printTokens(lexer, std::span<const Token>(&token, 1));
+        if (token.kind == TOK_EOF) {
+            break;
+        }
+        if (token.offset >= evicted + SourceBuffer::WindowSize) {
+            sourceManager.evict(fileID, evicted, token.offset);
+            evicted = token.offset;
+        }
+    }
+}
 
 int main(int argc, char** argv) {
-    if (argc < 2) {
-        std::cerr << "Usage: compiler <file>\n";
+    std::optional<DriverOptions> options = parseOptions(argc, argv);
+    if (!options.has_value()) {
+        std::cerr << "Usage: compiler [-j <lex-jobs>] [--token-cache <dir>] [--overlay <path>] [--windowed] [--error-limit <n>] [--diagnostic-format <text|jsonl|sarif>] [--diagnostic-output <path>] <file|->...\n";
         return EXIT_FAILURE;
     }
 
-    SourceManager sourceManager;
-    std::optional<ISourceManager::FileID> sourceFileID = sourceManager.loadFile(argv[1]);
-    if (!sourceFileID.has_value()) {
-        std::filesystem::path cwd = std::filesystem::current_path();
-        std::cout << "Current working directory: " << cwd << std::endl;
-        std::cerr << "Failed to load file: " << argv[1] << '\n';
-        return EXIT_FAILURE;
+    // `-` is standard input, it is lexed while it arrives rather than loaded up front
+    std::vector<std::string> filePaths;
+    std::copy_if(options->inputPaths.begin(), options->inputPaths.end(), std::back_inserter(filePaths), [](const std::string& path) {
+        return path != StdinPath;
+    });
+
+    // All files are loaded up front and concurrently, FileIDs follow the command line order.
+    // Windowed files are mapped and only indexed, their bytes are paged in while lexing
+    SourceManager sourceManager(options->isWindowed ? SourceBuffer::Mode::Windowed : SourceBuffer::Mode::Auto);
+
+    // An editor hands over an unsaved buffer on stdin, it replaces that path's contents on disk
+    if (options->stdinOverlayPath.has_value()) {
+        sourceManager.addOverlay(*options->stdinOverlayPath, std::string(std::istreambuf_iterator<char>(std::cin), {}));
     }
 
-    // Diagnostic engine tracks all warnings/errors across all compiler phases
-    DiagnosticEngine diagnosticEngine(sourceManager);
+    std::vector<std::optional<ISourceManager::FileID>> sourceFileIDs = sourceManager.loadFiles(filePaths);
+    for (size_t i = 0; i < sourceFileIDs.size(); ++i) {
+        if (!sourceFileIDs[i].has_value()) {
+            std::filesystem::path cwd = std::filesystem::current_path();
+            std::cout << "Current working directory: " << cwd << std::endl;
+            std::cerr << "Failed to load file: " << filePaths[i] << '\n';
+            return EXIT_FAILURE;
+        }
+    }
 
-    // Phase 1: Lexical Analysis (Tokenization)
-    Lexer lexer(sourceFileID.value(), sourceManager, diagnosticEngine);
-    std::vector<Token>& tokens = lexer.tokenize();
+    // Diagnostic engine tracks all warnings/errors across all compiler phases, once `--error-limit`
+    // errors are reported every phase stops early. 0 means no limit
+    DiagnosticEngine diagnosticEngine(sourceManager, options->errorLimit);
 
-    // Print all tokens generated from lexer
-    for (const auto& token : tokens) {
-        std::cout << std::format("Token: {}", TokenKindToString(token)) << '\n';
+    // Token streams of unchanged files are reused across runs when a cache directory is given
+    std::optional<TokenCache> tokenCache;
+    if (options->tokenCacheDirectory.has_value()) {
+        tokenCache.emplace(*options->tokenCacheDirectory);
     }
 
-    diagnosticEngine.printDiagnostics();
+    // Machine-readable diagnostics for CI are written as each file is lexed, `--diagnostic-output`
+    // keeps them apart from the tokens
+    std::FILE* diagnosticOutput = stdout;
+    std::optional<DiagnosticExporter> exporter;
+    if (options->diagnosticFormat.has_value()) {
+        if (options->diagnosticOutputPath.has_value()) {
+            diagnosticOutput = std::fopen(options->diagnosticOutputPath->c_str(), "wb");
+            if (diagnosticOutput == nullptr) {
+                std::cerr << "Failed to open diagnostic output: " << *options->diagnosticOutputPath << '\n';
+                return EXIT_FAILURE;
+            }
+        }
+        exporter.emplace(*options->diagnosticFormat, sourceManager, diagnosticOutput);
+    }
+    auto exportNewDiagnostics = [&]() {
+        if (!exporter.has_value()) {
+            return;
+        }
+        if (diagnosticOutput == stdout) {
+            std::cout.flush();
+        }
+        for (const Diagnostic& diagnostic : diagnosticEngine.getNewDiagnostics()) {
+            exporter->write(diagnostic);
+        }
+        exporter->flush();
+    };
+
+    auto nextFileID = sourceFileIDs.begin();
+    for (const std::string& inputPath : options->inputPaths) {
+        // Whatever the previous file reported is final
+        exportNewDiagnostics();
+
+        // Past the error limit the remaining files are not worth lexing
+        if (diagnosticEngine.shouldAbort()) {
+            break;
+        }
+
+        if (inputPath == StdinPath) {
+            // Tokens are printed as soon as later input can no longer change them, so a code
+            // generator can pipe into the compiler without a temporary file
+            StreamingLexer lexer(sourceManager.openStream("<stdin>"), sourceManager, diagnosticEngine, fileno(stdin));
+            while (!lexer.isDone()) {
+                printTokens(lexer, lexer.lexChunk());
+                exportNewDiagnostics();
+            }
+            continue;
+        }
+
+        const ISourceManager::FileID sourceFileID = (nextFileID++)->value();
+        if (options->isWindowed) {
+            Lexer lexer(sourceFileID, sourceManager, diagnosticEngine);
+            lexWindowed(lexer, sourceManager, sourceFileID);
+            continue;
+        }
+
+        const std::string_view source = sourceManager.getBuffer(sourceFileID);
+        const ContentHash hash = tokenCache.has_value() ? sourceManager.getContentHash(sourceFileID) : ContentHash{};
+        if (tokenCache.has_value()) {
+            if (std::optional<CachedTokens> cached = tokenCache->load(hash, source)) {
+                printTokens(*cached);
+                continue;
+            }
+        }
+
+        // Phase 1: Lexical Analysis (Tokenization), split across threads for large files when requested
+        if (options->lexJobs > 1) {
+            ParallelLexer lexer(sourceFileID, sourceManager, diagnosticEngine, options->lexJobs);
+            lexFile(lexer, tokenCache, hash, source, diagnosticEngine);
+        } else {
+            Lexer lexer(sourceFileID, sourceManager, diagnosticEngine);
+            lexFile(lexer, tokenCache, hash, source, diagnosticEngine);
+        }
+    }
+
+    exportNewDiagnostics();
+    if (exporter.has_value()) {
+        exporter->finish();
+        if (diagnosticOutput != stdout) {
+            std::fclose(diagnosticOutput);
+        }
+    } else {
+        diagnosticEngine.printDiagnostics();
+    }
 
     // skip codegen if any errors occurred
     if (diagnosticEngine.hasErrors()) {
@@ -0,0 +1,84 @@
+#include <string>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "CorpusGenerator.hpp"
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/Token.hpp"
+#include "Diagnostics/Diagnostic.hpp"
+#include "Diagnostics/DiagnosticBuffer.hpp"
+
+#include "SourceManager/MockSourceManager.hpp"
+
+struct CorpusGeneratorTestCase {
+    std::string name;
+    CorpusOptions options;
+};
+
+class CorpusGeneratorTest : public testing::Test, public testing::WithParamInterface<CorpusGeneratorTestCase> {};
+
+TEST_P(CorpusGeneratorTest, IsDeterministic) {
+    const CorpusGeneratorTestCase& testcase = GetParam();
+    EXPECT_EQ(CorpusGenerator(testcase.options).generate(), CorpusGenerator(testcase.options).generate());
+}
+
+TEST_P(CorpusGeneratorTest, ReachesRequestedSize) {
+    const CorpusGeneratorTestCase& testcase = GetParam();
+    EXPECT_GE(CorpusGenerator(testcase.options).generate().size(), testcase.options.size + testcase.options.hugeStringSize);
+}
+
+// Generated sources are valid Blaze, so lexing them must not report anything
+TEST_P(CorpusGeneratorTest, LexesWithoutDiagnostics) {
+    const CorpusGeneratorTestCase& testcase = GetParam();
+    const std::string source = CorpusGenerator(testcase.options).generate();
+
+    MockSourceManager sourceManager;
+    EXPECT_CALL(sourceManager, getBuffer(1)).WillOnce(testing::Return(sourceManager.addPaddedBuffer(source)));
+
+    DiagnosticBuffer diagnostics;
+    Lexer lexer(1, sourceManager, diagnostics);
+    std::vector<Token>& tokens = lexer.tokenize();
+
+    EXPECT_GT(tokens.size(), 1u);
+    for (const auto& diagnostic : diagnostics.getDiagnostics()) {
+        ADD_FAILURE() << formatMessage(diagnostic) << " at offset " << diagnostic.span.offset;
+    }
+    for (const Token& token : tokens) {
+        ASSERT_NE(token.kind, TOK_ERROR) << "at offset " << token.offset;
+    }
+}
+
+TEST(CorpusGeneratorSeedTest, SeedsProduceDifferentOutput) {
+    EXPECT_NE(CorpusGenerator({ .seed = 1, .size = 4096 }).generate(), CorpusGenerator({ .seed = 2, .size = 4096 }).generate());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    CorpusGenerator,
+    CorpusGeneratorTest,
+    testing::Values(
+        CorpusGeneratorTestCase{
+            .name = "Default",
+            .options = { .size = 64 * 1024 }
+        },
+
+        CorpusGeneratorTestCase{
+            .name = "UnicodeHeavy",
+            .options = { .seed = 7, .size = 32 * 1024, .unicodeRatio = 0.8 }
+        },
+
+        CorpusGeneratorTestCase{
+            .name = "LiteralsAndDeepComments",
+            .options = { .seed = 3, .size = 32 * 1024, .identifierDensity = 0.1, .commentRatio = 0.5, .commentNestingDepth = 8 }
+        },
+
+        CorpusGeneratorTestCase{
+            .name = "Pathological",
+            .options = { .seed = 11, .size = 16 * 1024, .hugeStringSize = 256 * 1024, .hugeCommentDepth = 10000 }
+        }
+    ),
+    [](const testing::TestParamInfo<CorpusGeneratorTestCase>& info) {
+        return info.param.name;
+    }
+);
@@ -0,0 +1,217 @@
+#include <span>
+#include <string>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "Diagnostics/Diagnostic.hpp"
+#include "Diagnostics/DiagnosticID.hpp"
+#include "Diagnostics/DiagnosticBuffer.hpp"
+#include "Diagnostics/DiagnosticBuilder.hpp"
+#include "Diagnostics/DiagnosticEngine.hpp"
+#include "SourceManager/SourceManager.hpp"
+
+TEST(DiagnosticBuilderTest, FillsInLevelAndCode) {
+    const Diagnostic diagnostic = DiagnosticBuilder(DiagnosticID::StringUnterminated).span({ 3, 42 }).build();
+    EXPECT_EQ(diagnostic.id, DiagnosticID::StringUnterminated);
+    EXPECT_EQ(diagnostic.level, DiagnosticLevel::Error);
+    EXPECT_STREQ(diagnostic.code, "E3101");
+    EXPECT_EQ(diagnostic.argumentCount, 0u);
+    EXPECT_EQ(formatMessage(diagnostic), "Unterminated string literal");
+    EXPECT_EQ(diagnostic.span.fileID, 3);
+    EXPECT_EQ(diagnostic.span.offset, 42u);
+}
+
+TEST(DiagnosticBuilderTest, FormatsArguments) {
+    const Diagnostic comment = DiagnosticBuilder(DiagnosticID::BlockCommentUnterminated).argument("document").build();
+    EXPECT_EQ(formatMessage(comment), "Unterminated document comment");
+
+    const Diagnostic symbol = DiagnosticBuilder(DiagnosticID::UnrecognizedSymbol).argument(U'€').build();
+    EXPECT_EQ(symbol.arguments[0].kind, DiagnosticArgument::Kind::Codepoint);
+    EXPECT_EQ(formatMessage(symbol), "Unrecogized symbol `€`");
+}
+
+TEST(DiagnosticBuilderTest, RejectsTooManyArguments) {
+    DiagnosticBuilder builder(DiagnosticID::UnrecognizedSymbol);
+    for (size_t i = 0; i < Diagnostic::MaxArguments; ++i) {
+        builder.argument("x");
+    }
+    EXPECT_THROW(builder.argument("x"), std::out_of_range);
+}
+
+// Every format must be fillable from `MaxArguments` arguments, fmt throws on a missing one
+TEST(DiagnosticInfoTest, FormatsFitMaxArguments) {
+    for (int id = 0; id <= static_cast<int>(DiagnosticID::TooManyErrors); ++id) {
+        DiagnosticBuilder builder(static_cast<DiagnosticID>(id));
+        for (size_t i = 0; i < Diagnostic::MaxArguments; ++i) {
+            builder.argument("x");
+        }
+        EXPECT_NO_THROW(formatMessage(builder.build())) << "DiagnosticID " << id;
+    }
+}
+
+// Engines own copies of string arguments, the reporter's buffer may be reused right away
+TEST(DiagnosticEngineTest, CopiesArguments) {
+    SourceManager sourceManager;
+    DiagnosticEngine engine(sourceManager);
+
+    std::string symbol;
+    for (int i = 0; i < 500; ++i) {
+        symbol = "symbol" + std::to_string(i);
+        engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::UnrecognizedSymbol).span({ 0, static_cast<size_t>(i) }).argument(symbol).build());
+    }
+    symbol.assign(symbol.size(), '?');
+
+    ASSERT_EQ(engine.getDiagnosticCount(), 500u);
+    for (int i = 0; i < 500; ++i) {
+        EXPECT_EQ(formatMessage(engine.getDiagnostics()[i]), "Unrecogized symbol `symbol" + std::to_string(i) + "`");
+        EXPECT_EQ(engine.getDiagnostics()[i].span.offset, static_cast<size_t>(i));
+    }
+}
+
+TEST(DiagnosticEngineTest, CountsByLevel) {
+    SourceManager sourceManager;
+    DiagnosticEngine engine(sourceManager);
+    EXPECT_FALSE(engine.hasErrors());
+
+    Diagnostic warning = DiagnosticBuilder(DiagnosticID::CharEmpty).build();
+    warning.level = DiagnosticLevel::Warning;
+    engine.addDiagnostic(warning);
+    EXPECT_FALSE(engine.hasErrors());
+    EXPECT_EQ(engine.getWarningCount(), 1u);
+
+    engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::CharEmpty).build());
+    engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::StringUnterminated).build());
+    EXPECT_TRUE(engine.hasErrors());
+    EXPECT_EQ(engine.getErrorCount(), 2u);
+    EXPECT_EQ(engine.getDiagnosticCount(), 3u);
+}
+
+TEST(DiagnosticEngineTest, SortsByFileAndOffset) {
+    SourceManager sourceManager;
+    DiagnosticEngine engine(sourceManager);
+
+    engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::CharEmpty).span({ 1, 5 }).build());
+    engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::CharEmpty).span({ 0, 9 }).build());
+    engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::CharEmpty).span({ 1, 2 }).build());
+
+    std::span<const Diagnostic> diagnostics = engine.getDiagnostics();
+    ASSERT_EQ(diagnostics.size(), 3u);
+    EXPECT_EQ(diagnostics[0].span.fileID, 0);
+    EXPECT_EQ(diagnostics[1].span.offset, 2u);
+    EXPECT_EQ(diagnostics[2].span.offset, 5u);
+
+    // Reporting after a merge merges again
+    engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::CharEmpty).span({ 0, 1 }).build());
+    ASSERT_EQ(engine.getDiagnostics().size(), 4u);
+    EXPECT_EQ(engine.getDiagnostics()[0].span.offset, 1u);
+}
+
+// Threads reporting interleaved offsets concurrently merge into the sequential order
+TEST(DiagnosticEngineTest, MergesConcurrentReports) {
+    constexpr size_t ThreadCount = 4;
+    constexpr size_t ReportsPerThread = 2000;
+
+    SourceManager sourceManager;
+    DiagnosticEngine engine(sourceManager);
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < ThreadCount; ++thread) {
+        threads.emplace_back([&engine, thread] {
+            for (size_t i = 0; i < ReportsPerThread; ++i) {
+                const size_t offset = i * ThreadCount + thread;
+                const std::string symbol = std::to_string(offset);
+                engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::UnrecognizedSymbol).span({ 0, offset }).argument(symbol).build());
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(engine.getErrorCount(), ThreadCount * ReportsPerThread);
+    std::span<const Diagnostic> diagnostics = engine.getDiagnostics();
+    ASSERT_EQ(diagnostics.size(), ThreadCount * ReportsPerThread);
+    for (size_t i = 0; i < diagnostics.size(); ++i) {
+        EXPECT_EQ(diagnostics[i].span.offset, i);
+        EXPECT_EQ(formatMessage(diagnostics[i]), "Unrecogized symbol `" + std::to_string(i) + "`");
+    }
+}
+
+TEST(DiagnosticEngineTest, StopsAtErrorLimit) {
+    SourceManager sourceManager;
+    DiagnosticEngine engine(sourceManager, 3);
+    EXPECT_EQ(engine.getErrorLimit(), 3u);
+
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(engine.shouldAbort(), i >= 3);
+        engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::CharEmpty).span({ 0, i }).build());
+    }
+
+    EXPECT_EQ(engine.getErrorCount(), 3u);
+    std::span<const Diagnostic> diagnostics = engine.getDiagnostics();
+    ASSERT_EQ(diagnostics.size(), 4u);
+    EXPECT_EQ(diagnostics[2].span.offset, 2u);
+    EXPECT_EQ(diagnostics[3].id, DiagnosticID::TooManyErrors);
+    EXPECT_EQ(diagnostics[3].level, DiagnosticLevel::Fatal);
+    EXPECT_EQ(diagnostics[3].span.offset, 2u);
+    EXPECT_EQ(formatMessage(diagnostics[3]), "Too many errors, stopping after 3");
+}
+
+// Each call returns only what was reported since the previous one, sorted within the batch
+TEST(DiagnosticEngineTest, ReturnsNewDiagnosticsOnce) {
+    SourceManager sourceManager;
+    DiagnosticEngine engine(sourceManager, 4);
+
+    engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::CharEmpty).span({ 0, 7 }).build());
+    engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::CharEmpty).span({ 0, 3 }).build());
+    std::span<const Diagnostic> first = engine.getNewDiagnostics();
+    ASSERT_EQ(first.size(), 2u);
+    EXPECT_EQ(first[0].span.offset, 3u);
+    EXPECT_EQ(first[1].span.offset, 7u);
+    EXPECT_TRUE(engine.getNewDiagnostics().empty());
+
+    for (size_t i = 0; i < 3; ++i) {
+        engine.addDiagnostic(DiagnosticBuilder(DiagnosticID::CharEmpty).span({ 1, i }).build());
+    }
+    std::span<const Diagnostic> second = engine.getNewDiagnostics();
+    ASSERT_EQ(second.size(), 3u);
+    EXPECT_EQ(second[0].span.fileID, 1);
+    EXPECT_EQ(second[1].span.fileID, 1);
+    EXPECT_EQ(second[2].id, DiagnosticID::TooManyErrors);
+    EXPECT_TRUE(engine.getNewDiagnostics().empty());
+    EXPECT_EQ(engine.getDiagnostics().size(), 5u);
+}
+
+TEST(DiagnosticBufferTest, AbortsAtItsOwnErrorLimit) {
+    DiagnosticBuffer buffer;
+    buffer.setErrorLimit(2);
+    buffer.addDiagnostic(DiagnosticBuilder(DiagnosticID::CharEmpty).build());
+    EXPECT_FALSE(buffer.shouldAbort());
+    buffer.addDiagnostic(DiagnosticBuilder(DiagnosticID::CharEmpty).build());
+    EXPECT_TRUE(buffer.shouldAbort());
+
+    buffer.clear();
+    EXPECT_FALSE(buffer.shouldAbort());
+}
+
+TEST(DiagnosticBufferTest, FlushesInOrderAndClears) {
+    SourceManager sourceManager;
+    DiagnosticEngine engine(sourceManager);
+    DiagnosticBuffer buffer;
+
+    for (int i = 0; i < 3; ++i) {
+        const std::string suffix = "s" + std::to_string(i);
+        buffer.addDiagnostic(DiagnosticBuilder(DiagnosticID::NumberLiteralInvalidSuffix).argument(suffix).build());
+    }
+    ASSERT_EQ(buffer.getDiagnostics().size(), 3u);
+    EXPECT_EQ(formatMessage(buffer.getDiagnostics()[1]), "Invalid suffix `s1` on number literal");
+
+    buffer.flush(engine);
+    EXPECT_TRUE(buffer.getDiagnostics().empty());
+    ASSERT_EQ(engine.getDiagnosticCount(), 3u);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(formatMessage(engine.getDiagnostics()[i]), "Invalid suffix `s" + std::to_string(i) + "` on number literal");
+    }
+}
@@ -0,0 +1,107 @@
+#include <cstdio>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Diagnostics/Diagnostic.hpp"
+#include "Diagnostics/DiagnosticID.hpp"
+#include "Diagnostics/DiagnosticBuilder.hpp"
+#include "Diagnostics/DiagnosticExporter.hpp"
+#include "SourceManager/SourceManager.hpp"
+
+class DiagnosticExporterTest : public testing::Test {
+protected:
+    SourceManager m_sourceManager;
+    ISourceManager::FileID m_fileID = 0;
+    std::FILE* m_output = nullptr;
+
+    void SetUp() override {
+        m_sourceManager.addOverlay("dir/main.bz", "let x = 1;\nlet é = $;\n");
+        m_fileID = m_sourceManager.loadFile("dir/main.bz").value();
+        m_output = std::tmpfile();
+        ASSERT_NE(m_output, nullptr);
+    }
+
+    void TearDown() override {
+        std::fclose(m_output);
+    }
+
+    std::string readOutput() {
+        std::string contents(static_cast<size_t>(std::ftell(m_output)), '\0');
+        std::rewind(m_output);
+        contents.resize(std::fread(contents.data(), 1, contents.size(), m_output));
+        return contents;
+    }
+
+    std::string getPath() const {
+        return std::string(m_sourceManager.getPath(m_fileID));
+    }
+};
+
+TEST_F(DiagnosticExporterTest, WritesJsonLines) {
+    {
+        DiagnosticExporter exporter(DiagnosticExporter::Format::JsonLines, m_sourceManager, m_output);
+        exporter.write(DiagnosticBuilder(DiagnosticID::UnrecognizedSymbol).span({ m_fileID, 20 }).argument(U'$').build());
+        exporter.write(DiagnosticBuilder(DiagnosticID::NumberLiteralInvalidSuffix).span({ m_fileID, 8 }).argument("\"\\\n\x01\xFF").build());
+    }
+
+    EXPECT_EQ(readOutput(),
+        R"({"code":"E1010","level":"error","message":"Unrecogized symbol `$`","span":{"fileID":)" + std::to_string(m_fileID) +
+        R"(,"path":")" + getPath() + R"(","offset":20,"line":2,"column":9}})" "\n"
+        R"({"code":"E2001","level":"error","message":"Invalid suffix `\"\\\n\u0001\ufffd` on number literal","span":{"fileID":)" + std::to_string(m_fileID) +
+        R"(,"path":")" + getPath() + R"(","offset":8,"line":1,"column":9}})" "\n"
+    );
+}
+
+TEST_F(DiagnosticExporterTest, WritesSarif) {
+    DiagnosticExporter exporter(DiagnosticExporter::Format::Sarif, m_sourceManager, m_output);
+    exporter.write(DiagnosticBuilder(DiagnosticID::CharEmpty).span({ m_fileID, 4 }).build());
+    exporter.write(DiagnosticBuilder(DiagnosticID::TooManyErrors).span({ m_fileID, 4 }).argument("1").build());
+    exporter.finish();
+
+    const std::string output = readOutput();
+    EXPECT_TRUE(output.starts_with(R"({"version":"2.1.0",)"));
+    EXPECT_NE(output.find(
+        R"({"ruleId":"E3001","level":"error","message":{"text":"Character literal cannot be empty"},)"
+        R"("locations":[{"physicalLocation":{"artifactLocation":{"uri":"file://)" + getPath() + R"("},)"
+        R"("region":{"startLine":1,"startColumn":5,"byteOffset":4}}}]},{"ruleId":"E0001","level":"error")"
+    ), std::string::npos);
+    EXPECT_TRUE(output.ends_with("}]}]}\n"));
+}
+
+// Paths become URIs, bytes that are not unreserved are percent-encoded
+TEST_F(DiagnosticExporterTest, WritesSarifUris) {
+    m_sourceManager.addOverlay("/virtual/my file#1 é.bz", "x");
+    const ISourceManager::FileID fileID = m_sourceManager.loadFile("/virtual/my file#1 é.bz").value();
+    const ISourceManager::FileID streamID = m_sourceManager.openStream("<stdin>");
+
+    DiagnosticExporter exporter(DiagnosticExporter::Format::Sarif, m_sourceManager, m_output);
+    exporter.write(DiagnosticBuilder(DiagnosticID::CharEmpty).span({ fileID, 0 }).build());
+    exporter.write(DiagnosticBuilder(DiagnosticID::CharEmpty).span({ streamID, 0 }).build());
+    exporter.finish();
+
+    const std::string output = readOutput();
+    EXPECT_NE(output.find(R"("uri":"file:///virtual/my%20file%231%20%C3%A9.bz")"), std::string::npos);
+    EXPECT_NE(output.find(R"("uri":"%3Cstdin%3E")"), std::string::npos);
+}
+
+// A run without diagnostics still produces a complete SARIF document
+TEST_F(DiagnosticExporterTest, WritesEmptySarif) {
+    DiagnosticExporter exporter(DiagnosticExporter::Format::Sarif, m_sourceManager, m_output);
+    exporter.finish();
+    exporter.finish();
+
+    const std::string output = readOutput();
+    EXPECT_TRUE(output.starts_with(R"({"version":"2.1.0",)"));
+    EXPECT_TRUE(output.ends_with(R"("results":[]}]})" "\n"));
+}
+
+// Output is flushed as the buffer fills up rather than held until the end
+TEST_F(DiagnosticExporterTest, FlushesWhileWriting) {
+    DiagnosticExporter exporter(DiagnosticExporter::Format::JsonLines, m_sourceManager, m_output);
+    const Diagnostic diagnostic = DiagnosticBuilder(DiagnosticID::CharEmpty).span({ m_fileID, 0 }).build();
+    while (std::ftell(m_output) == 0) {
+        exporter.write(diagnostic);
+    }
+    EXPECT_GE(static_cast<size_t>(std::ftell(m_output)), DiagnosticExporter::BufferSize);
+}
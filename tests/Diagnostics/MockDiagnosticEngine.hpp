@@ -9,5 +9,5 @@ class MockDiagnosticEngine : public IDiagnosticEngine {
 public:
     ~MockDiagnosticEngine() override {};
 
-    MOCK_METHOD(void, addDiagnostic, (std::unique_ptr<Diagnostic> diagnostic), (override));
+    MOCK_METHOD(void, addDiagnostic, (const Diagnostic& diagnostic), (override));
 };
@@ -9,15 +9,22 @@
 #include "Lexer/Lexer.hpp"
 #include "Lexer/Token.hpp"
 #include "SourceManager/SourceManager.hpp"
+#include "SourceManager/LineTable.hpp"
 
 #include "SourceManager/MockSourceManager.hpp"
 #include "Diagnostics/MockDiagnosticEngine.hpp"
 
+struct ExpectedToken {
+    TokenKind kind;
+    std::pair<size_t, size_t> position;
+    std::string lexeme;
+};
+
 struct LexerTestCase {
     std::string name;
     ISourceManager::FileID fileID;
     std::string source;
-    std::vector<Token> expectedTokens;
+    std::vector<ExpectedToken> expectedTokens;
 };
 
 class LexerBaseTest : public testing::Test, public testing::WithParamInterface<LexerTestCase> {
@@ -25,20 +32,24 @@ protected:
     MockSourceManager m_sourceManager;
     MockDiagnosticEngine m_diagnosticEngine;
     std::unique_ptr<Lexer> m_lexer;
+    LineTable m_lineTable;
 
     void SetUp() override {
         const LexerTestCase& testcase = GetParam();
-        EXPECT_CALL(m_sourceManager, getBuffer(testcase.fileID)).WillOnce(testing::Return(testcase.source));
+        EXPECT_CALL(m_sourceManager, getBuffer(testcase.fileID)).WillOnce(testing::Return(m_sourceManager.addPaddedBuffer(testcase.source)));
         m_lexer = std::make_unique<Lexer>(Lexer(testcase.fileID, m_sourceManager, m_diagnosticEngine));
+        m_lineTable = LineTable(testcase.source);
     }
 
-    void CheckTokens(const std::vector<Token>& expectedTokens, const std::vector<Token>& recievedTokens) {
+    void CheckTokens(const std::vector<ExpectedToken>& expectedTokens, const std::vector<Token>& recievedTokens) {
         ASSERT_EQ(expectedTokens.size(), recievedTokens.size());
         for (int i = 0; i < recievedTokens.size(); ++i) {
-            SCOPED_TRACE(testing::Message() << std::format("Expected: {}, Received: {}", TokenKindToString(expectedTokens[i]), TokenKindToString(recievedTokens[i])));
+            std::string_view recievedLexeme = m_lexer->getLexeme(recievedTokens[i]);
+            SCOPED_TRACE(testing::Message() << std::format("Expected: {}, Received: {}", TokenKindToString(expectedTokens[i].kind, expectedTokens[i].lexeme), TokenKindToString(recievedTokens[i].kind, recievedLexeme)));
             EXPECT_EQ(recievedTokens[i].kind, expectedTokens[i].kind);
-            EXPECT_EQ(recievedTokens[i].lexeme, expectedTokens[i].lexeme);
-            EXPECT_EQ(recievedTokens[i].position, expectedTokens[i].position);
+            EXPECT_EQ(recievedLexeme, expectedTokens[i].lexeme);
+            std::pair<size_t, size_t> recievedPosition = m_lineTable.getLineColumn(recievedTokens[i].offset);
+            EXPECT_EQ(recievedPosition, expectedTokens[i].position);
         }
     }
 };
@@ -36,6 +36,38 @@ INSTANTIATE_TEST_SUITE_P(
             }
         },
 
+        // NUL is content, only the one past the end terminates the scan
+        LexerTestCase{
+            .name = "NulInsideLineComment",
+            .fileID = 1,
+            .source = std::string("// a\0b\nx", 8),
+            .expectedTokens = {
+                {TOK_IDENTIFIER, {2, 1}, "x"},
+                {TOK_EOF, {2, 2}, ""}
+            }
+        },
+
+        LexerTestCase{
+            .name = "NulInsideBlockComment",
+            .fileID = 1,
+            .source = std::string("/* \0 */x", 8),
+            .expectedTokens = {
+                {TOK_IDENTIFIER, {1, 8}, "x"},
+                {TOK_EOF, {1, 9}, ""}
+            }
+        },
+
+        // Lone delimiter characters spread over several 16-byte scan blocks
+        LexerTestCase{
+            .name = "BlockCommentWithStrayDelimiters",
+            .fileID = 1,
+            .source = "/* a * b / c ** d // e *** f // g * h / i */x",
+            .expectedTokens = {
+                {TOK_IDENTIFIER, {1, 45}, "x"},
+                {TOK_EOF, {1, 46}, ""}
+            }
+        },
+
         // Nested block comment (if supported)
         LexerTestCase{
             .name = "NestedBlockComment",
@@ -90,6 +90,18 @@ INSTANTIATE_TEST_SUITE_P(
             }
         },
 
+        // NFKC normalized identifiers (ligature "ﬁ" normalizes to "fi")
+        LexerTestCase{
+            .name = "NormalizedIdentifier",
+            .fileID = 1,
+            .source = "ﬁle ﬁle",
+            .expectedTokens = {
+                {TOK_IDENTIFIER, {1, 1}, "file"},
+                {TOK_IDENTIFIER, {1, 5}, "file"},
+                {TOK_EOF, {1, 8}, ""}
+            }
+        },
+
         // Invalid characters (e.g., operators or symbols in identifier)
         LexerTestCase{
             .name = "InvalidCharacterInIdentifier",
@@ -64,6 +64,33 @@ INSTANTIATE_TEST_SUITE_P(
 
                 {TOK_EOF,      {1, 167}, ""}
             }
+        },
+
+        // Near misses must stay identifiers
+        LexerTestCase{
+            .name = "KeywordLikeIdentifiers",
+            .fileID = 1,
+            .source = "lets iff u1 i1280 elsif _if",
+            .expectedTokens = {
+                {TOK_IDENTIFIER, {1, 1},  "lets"},
+                {TOK_IDENTIFIER, {1, 6},  "iff"},
+                {TOK_IDENTIFIER, {1, 10}, "u1"},
+                {TOK_IDENTIFIER, {1, 13}, "i1280"},
+                {TOK_IDENTIFIER, {1, 19}, "elsif"},
+                {TOK_IDENTIFIER, {1, 25}, "_if"},
+                {TOK_EOF,        {1, 28}, ""}
+            }
+        },
+
+        // Fullwidth letters normalize (NFKC) to a keyword
+        LexerTestCase{
+            .name = "NormalizedKeyword",
+            .fileID = 1,
+            .source = "ｌｅｔ",
+            .expectedTokens = {
+                {TOK_LET, {1, 1}, "ｌｅｔ"},
+                {TOK_EOF, {1, 4}, ""}
+            }
         }
     ),
     [](const testing::TestParamInfo<LexerTestCase>& info) {
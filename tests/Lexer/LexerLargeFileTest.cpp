@@ -0,0 +1,76 @@
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/Token.hpp"
+#include "SourceManager/SourceManager.hpp"
+#include "Diagnostics/DiagnosticBuffer.hpp"
+
+// A sparse file just over 4 GiB whose only source is at the end, everything before is a hole
+// that reads as NUL. Lexing starts at the tail, so offsets past 2 and 4 GiB go through the
+// decoder, the tokens and the line table without lexing gigabytes.
+class LexerLargeFileTest : public testing::Test {
+protected:
+    static constexpr uint64_t TailOffset = (uint64_t(1) << 32) + 4096;
+    static constexpr std::string_view Tail = "let größe = \"ü\";\n";
+
+    std::filesystem::path m_path = std::filesystem::temp_directory_path() / "blaze_large_file.bz";
+
+    void SetUp() override {
+        const int fd = open(m_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+        ASSERT_GE(fd, 0);
+
+        // The newline ends the NUL line, so columns on the tail line are counted from the tail
+        const std::string contents = "\n" + std::string(Tail);
+        const ssize_t written = pwrite(fd, contents.data(), contents.size(), static_cast<off_t>(TailOffset - 1));
+        close(fd);
+        if (written != static_cast<ssize_t>(contents.size())) {
+            GTEST_SKIP() << "cannot create a sparse file over 4 GiB";
+        }
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(m_path);
+    }
+};
+
+TEST_F(LexerLargeFileTest, OffsetsPast4GiB) {
+    SourceManager sourceManager(SourceBuffer::Mode::Windowed);
+    std::optional<ISourceManager::FileID> fileID = sourceManager.loadFile(m_path.string());
+    ASSERT_TRUE(fileID.has_value());
+    ASSERT_EQ(sourceManager.getBuffer(fileID.value()).size(), TailOffset + Tail.size());
+
+    DiagnosticBuffer diagnostics;
+    Lexer lexer(fileID.value(), sourceManager, diagnostics, TailOffset, SIZE_MAX);
+    const std::vector<Token>& tokens = lexer.tokenize();
+    EXPECT_TRUE(diagnostics.getDiagnostics().empty());
+
+    const std::vector<std::pair<TokenKind, std::string_view>> expected = {
+        { TOK_LET, "let" },
+        { TOK_IDENTIFIER, "größe" },
+        { TOK_ASSIGN, "=" },
+        { TOK_STRING_LITERAL, "\"ü\"" },
+        { TOK_SEMICOLON, ";" },
+        { TOK_EOF, "" },
+    };
+    ASSERT_EQ(tokens.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(tokens[i].kind, expected[i].first) << "token " << i;
+        EXPECT_EQ(lexer.getLexeme(tokens[i]), expected[i].second) << "token " << i;
+    }
+    EXPECT_EQ(tokens[1].offset, TailOffset + 4);
+    EXPECT_EQ(tokens.back().offset, TailOffset + Tail.size());
+
+    const LineTable& lineTable = sourceManager.getLineTable(fileID.value());
+    EXPECT_EQ(lineTable.getLineCount(), 3);
+    EXPECT_EQ(lineTable.getLineStart(2), TailOffset);
+    EXPECT_EQ(lineTable.getLineColumn(tokens[2].offset), std::make_pair(size_t(2), size_t(11)));
+}
@@ -0,0 +1,248 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "CorpusGenerator.hpp"
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/Token.hpp"
+#include "Diagnostics/DiagnosticBuffer.hpp"
+
+#include "SourceManager/SourceManager.hpp"
+
+struct RelexTestCase {
+    std::string name;
+    std::string source;
+    size_t offset;
+    size_t removedLength;
+    std::string text;
+};
+
+class LexerRelexTest : public testing::Test {
+protected:
+    SourceManager m_sourceManager;
+    DiagnosticBuffer m_diagnostics;
+    ISourceManager::FileID m_fileID = 0;
+    std::string m_source;
+
+    // Registers the source as an in-memory file, the lexers of a test read it from there
+    void LoadSource(std::string source) {
+        m_source = std::move(source);
+        m_sourceManager.addOverlay("relex.bz", m_source);
+        m_fileID = m_sourceManager.loadFile("relex.bz").value();
+    }
+
+    // Applies the edit to the source and checks the relexed stream against a fresh full lex
+    size_t CheckRelex(Lexer& lexer, size_t offset, size_t removedLength, std::string_view text) {
+        m_source.replace(offset, removedLength, text);
+        const size_t relexedCount = lexer.relex(m_sourceManager.applyEdit(m_fileID, { offset, removedLength }, text));
+        EXPECT_EQ(m_sourceManager.getBuffer(m_fileID), m_source);
+
+        Lexer fresh(m_fileID, m_sourceManager, m_diagnostics);
+        const std::vector<Token>& expectedTokens = fresh.tokenize();
+        const std::vector<Token>& tokens = lexer.tokenize();
+
+        EXPECT_EQ(tokens.size(), expectedTokens.size());
+        EXPECT_EQ(std::count_if(tokens.begin(), tokens.end(), [](const Token& token) { return token.kind == TOK_EOF; }), 1);
+        for (size_t i = 0; i < std::min(tokens.size(), expectedTokens.size()); ++i) {
+            SCOPED_TRACE(testing::Message() << "Token #" << i);
+            EXPECT_EQ(tokens[i].kind, expectedTokens[i].kind);
+            EXPECT_EQ(tokens[i].offset, expectedTokens[i].offset);
+            EXPECT_EQ(tokens[i].length, expectedTokens[i].length);
+            EXPECT_EQ(lexer.getLexeme(tokens[i]), fresh.getLexeme(expectedTokens[i]));
+        }
+        return relexedCount;
+    }
+};
+
+class LexerRelexEditTest : public LexerRelexTest, public testing::WithParamInterface<RelexTestCase> {};
+
+TEST_P(LexerRelexEditTest, MatchesFullLex) {
+    const RelexTestCase& testcase = GetParam();
+    LoadSource(testcase.source);
+
+    Lexer lexer(m_fileID, m_sourceManager, m_diagnostics);
+    lexer.tokenize();
+    CheckRelex(lexer, testcase.offset, testcase.removedLength, testcase.text);
+}
+
+// A keystroke in a large file only relexes around the edit
+TEST_F(LexerRelexTest, SmallEditRelexesFewTokens) {
+    LoadSource(CorpusGenerator({ .size = 256 * 1024 }).generate());
+
+    Lexer lexer(m_fileID, m_sourceManager, m_diagnostics);
+    lexer.tokenize();
+    const size_t offset = m_source.find("let ", m_source.size() / 2) + 4;
+    EXPECT_LT(CheckRelex(lexer, offset, 0, "x"), 8u);
+}
+
+// Random edits to a generated corpus, each checked against a full lex
+TEST_F(LexerRelexTest, RandomEditsMatchFullLex) {
+    LoadSource(CorpusGenerator({ .seed = 5, .size = 16 * 1024, .unicodeRatio = 0.3, .commentRatio = 0.3 }).generate());
+    const std::string_view snippets[] = { "x", "\"", "/*", "*/", "'", "\n", "12", ".", "//", "ä", "<<=", " " };
+
+    Lexer lexer(m_fileID, m_sourceManager, m_diagnostics);
+    lexer.tokenize();
+
+    uint64_t state = 42;
+    auto random = [&state](size_t bound) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<size_t>((state >> 33) % bound);
+    };
+
+    for (int i = 0; i < 200; ++i) {
+        SCOPED_TRACE(testing::Message() << "Edit #" << i);
+        size_t offset = random(m_source.size() + 1);
+        size_t removedLength = std::min(random(4), m_source.size() - offset);
+        // Keep edits on codepoint boundaries
+        while (offset > 0 && (static_cast<uint8_t>(m_source[offset]) & 0xC0) == 0x80) {
+            offset -= 1;
+        }
+        while (offset + removedLength < m_source.size() && (static_cast<uint8_t>(m_source[offset + removedLength]) & 0xC0) == 0x80) {
+            removedLength += 1;
+        }
+        CheckRelex(lexer, offset, removedLength, snippets[random(std::size(snippets))]);
+        if (testing::Test::HasFailure()) {
+            break;
+        }
+    }
+}
+
+// Edits confined to a leading comment, where no old token precedes the damage
+TEST_F(LexerRelexTest, RandomLeadingTriviaEditsMatchFullLex) {
+    LoadSource("/* header\n * text */\n// line\n" + CorpusGenerator({ .seed = 9, .size = 2 * 1024 }).generate());
+    const std::string_view snippets[] = { "x", "*/", "/*", "\n", "\"", "//", " " };
+
+    Lexer lexer(m_fileID, m_sourceManager, m_diagnostics);
+    lexer.tokenize();
+
+    uint64_t state = 7;
+    auto random = [&state](size_t bound) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<size_t>((state >> 33) % bound);
+    };
+
+    for (int i = 0; i < 200; ++i) {
+        SCOPED_TRACE(testing::Message() << "Edit #" << i);
+        const size_t offset = random(32);
+        const size_t removedLength = random(3);
+        CheckRelex(lexer, offset, removedLength, snippets[random(std::size(snippets))]);
+        if (testing::Test::HasFailure()) {
+            break;
+        }
+    }
+}
+
+// Replaced identifiers hand their spelling slots to the relexed ones
+TEST_F(LexerRelexTest, ReusesSpellingSlots) {
+    LoadSource("let ﬁle = ﬁx;\n");
+
+    Lexer lexer(m_fileID, m_sourceManager, m_diagnostics);
+    lexer.tokenize();
+    const size_t spellingCount = lexer.getSpellings().size();
+    for (int i = 0; i < 50; ++i) {
+        CheckRelex(lexer, 4, 0, "x");
+        CheckRelex(lexer, 4, 1, "");
+    }
+    EXPECT_EQ(lexer.getSpellings().size(), spellingCount);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    LexerRelex,
+    LexerRelexEditTest,
+    testing::Values(
+        RelexTestCase{
+            .name = "ExtendIdentifier",
+            .source = "let foo = bar;\nlet baz = 1;\n",
+            .offset = 7,
+            .removedLength = 0,
+            .text = "d"
+        },
+
+        RelexTestCase{
+            .name = "MergeOperators",
+            .source = "a < b;\nc = d;\n",
+            .offset = 3,
+            .removedLength = 0,
+            .text = "<="
+        },
+
+        RelexTestCase{
+            .name = "CompleteFloat",
+            .source = "let x = 1. ;\nlet y = 2;\n",
+            .offset = 10,
+            .removedLength = 0,
+            .text = "5"
+        },
+
+        RelexTestCase{
+            .name = "OpenBlockComment",
+            .source = "let a = 1;\nlet b = 2;\n*/ let c = 3;\n",
+            .offset = 0,
+            .removedLength = 0,
+            .text = "/*"
+        },
+
+        RelexTestCase{
+            .name = "CloseStringEarly",
+            .source = "let s = \"hello world\";\nlet t = 1;\n",
+            .offset = 14,
+            .removedLength = 0,
+            .text = "\" + \""
+        },
+
+        RelexTestCase{
+            .name = "DeleteLine",
+            .source = "let a = 1;\nlet b = 2;\nlet c = 3;\n",
+            .offset = 11,
+            .removedLength = 11,
+            .text = ""
+        },
+
+        RelexTestCase{
+            .name = "AppendAtEnd",
+            .source = "let a = 1;",
+            .offset = 10,
+            .removedLength = 0,
+            .text = "\nlet b = ﬁle;"
+        },
+
+        // Edits before the first token land in trivia that no old token covers
+        RelexTestCase{
+            .name = "EditLeadingLineComment",
+            .source = "// note\nlet x = 1;\n",
+            .offset = 0,
+            .removedLength = 1,
+            .text = "a"
+        },
+
+        RelexTestCase{
+            .name = "CloseLeadingBlockComment",
+            .source = "/* c */ a",
+            .offset = 3,
+            .removedLength = 0,
+            .text = "*/ b /*"
+        },
+
+        RelexTestCase{
+            .name = "InsertBeforeLeadingWhitespace",
+            .source = "   \n\tlet x = 1;",
+            .offset = 1,
+            .removedLength = 0,
+            .text = "y"
+        },
+
+        RelexTestCase{
+            .name = "ReplaceWholeSource",
+            .source = "let a = 1;",
+            .offset = 0,
+            .removedLength = 10,
+            .text = "fn main() {}"
+        }
+    ),
+    [](const testing::TestParamInfo<RelexTestCase>& info) {
+        return info.param.name;
+    }
+);
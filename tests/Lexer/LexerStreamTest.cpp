@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "Lexer/Token.hpp"
+
+#include "Lexer/LexerBaseTest.cc"
+
+class LexerStreamTest : public LexerBaseTest {};
+
+TEST_P(LexerStreamTest, NextMatchesTokenize) {
+    const LexerTestCase& testcase = GetParam();
+
+    std::vector<Token> tokens;
+    do {
+        tokens.push_back(m_lexer->next());
+    } while (tokens.back().kind != TOK_EOF);
+
+    CheckTokens(testcase.expectedTokens, tokens);
+
+    // The stream keeps returning EOF once exhausted
+    EXPECT_EQ(m_lexer->next().kind, TOK_EOF);
+    EXPECT_EQ(m_lexer->peek(3).kind, TOK_EOF);
+}
+
+TEST_P(LexerStreamTest, PeekDoesNotConsume) {
+    const LexerTestCase& testcase = GetParam();
+
+    for (size_t i = 0; i < testcase.expectedTokens.size(); ++i) {
+        size_t ahead = std::min(testcase.expectedTokens.size() - i, Lexer::LookaheadCapacity) - 1;
+        EXPECT_EQ(m_lexer->peek(ahead).kind, testcase.expectedTokens[i + ahead].kind);
+        EXPECT_EQ(m_lexer->peek(0).kind, testcase.expectedTokens[i].kind);
+        EXPECT_EQ(m_lexer->next().kind, testcase.expectedTokens[i].kind);
+    }
+}
+
+TEST_P(LexerStreamTest, PeekBeyondCapacityThrows) {
+    EXPECT_THROW(m_lexer->peek(Lexer::LookaheadCapacity), std::out_of_range);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    LexerStream,
+    LexerStreamTest,
+    testing::Values(
+        LexerTestCase{
+            .name = "EmptySource",
+            .fileID = 1,
+            .source = "",
+            .expectedTokens = {
+                {TOK_EOF, {1, 1}, ""}
+            }
+        },
+
+        LexerTestCase{
+            .name = "SkipsCommentsAndWhitespace",
+            .fileID = 1,
+            .source = "let x /* skipped */ = 1; // trailing\nx",
+            .expectedTokens = {
+                {TOK_LET, {1, 1}, "let"},
+                {TOK_IDENTIFIER, {1, 5}, "x"},
+                {TOK_ASSIGN, {1, 21}, "="},
+                {TOK_INTEGER_LITERAL, {1, 23}, "1"},
+                {TOK_SEMICOLON, {1, 24}, ";"},
+                {TOK_IDENTIFIER, {2, 1}, "x"},
+                {TOK_EOF, {2, 2}, ""}
+            }
+        },
+
+        // More tokens than the lookahead buffer holds
+        LexerTestCase{
+            .name = "LongerThanLookahead",
+            .fileID = 1,
+            .source = "a b c d e f g h i j k l m n o p q r s t",
+            .expectedTokens = {
+                {TOK_IDENTIFIER, {1, 1}, "a"},
+                {TOK_IDENTIFIER, {1, 3}, "b"},
+                {TOK_IDENTIFIER, {1, 5}, "c"},
+                {TOK_IDENTIFIER, {1, 7}, "d"},
+                {TOK_IDENTIFIER, {1, 9}, "e"},
+                {TOK_IDENTIFIER, {1, 11}, "f"},
+                {TOK_IDENTIFIER, {1, 13}, "g"},
+                {TOK_IDENTIFIER, {1, 15}, "h"},
+                {TOK_IDENTIFIER, {1, 17}, "i"},
+                {TOK_IDENTIFIER, {1, 19}, "j"},
+                {TOK_IDENTIFIER, {1, 21}, "k"},
+                {TOK_IDENTIFIER, {1, 23}, "l"},
+                {TOK_IDENTIFIER, {1, 25}, "m"},
+                {TOK_IDENTIFIER, {1, 27}, "n"},
+                {TOK_IDENTIFIER, {1, 29}, "o"},
+                {TOK_IDENTIFIER, {1, 31}, "p"},
+                {TOK_IDENTIFIER, {1, 33}, "q"},
+                {TOK_IDENTIFIER, {1, 35}, "r"},
+                {TOK_IDENTIFIER, {1, 37}, "s"},
+                {TOK_IDENTIFIER, {1, 39}, "t"},
+                {TOK_EOF, {1, 40}, ""}
+            }
+        }
+    ),
+    [](const testing::TestParamInfo<LexerTestCase>& info) {
+        return info.param.name;
+    }
+);
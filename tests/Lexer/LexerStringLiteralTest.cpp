@@ -91,7 +91,27 @@ INSTANTIATE_TEST_SUITE_P(
             .source = "\"hello\nworld\"",
             .expectedTokens = {
                 {TOK_STRING_LITERAL, {1, 1}, "\"hello\nworld\""},
-                {TOK_EOF, {2, 8}, ""}
+                {TOK_EOF, {2, 7}, ""}
+            }
+        },
+
+        LexerTestCase{
+            .name = "NulInsideString",
+            .fileID = 1,
+            .source = std::string("\"a\0b\"", 5),
+            .expectedTokens = {
+                {TOK_STRING_LITERAL, {1, 1}, std::string("\"a\0b\"", 5)},
+                {TOK_EOF, {1, 6}, ""}
+            }
+        },
+
+        LexerTestCase{
+            .name = "LongStringWithEscapes",
+            .fileID = 1,
+            .source = "\"the quick brown fox jumps\\nover the lazy dog \\t again and again\"",
+            .expectedTokens = {
+                {TOK_STRING_LITERAL, {1, 1}, "\"the quick brown fox jumps\\nover the lazy dog \\t again and again\""},
+                {TOK_EOF, {1, 66}, ""}
             }
         },
 
@@ -0,0 +1,178 @@
+#include <span>
+#include <string>
+#include <format>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/ParallelLexer.hpp"
+#include "Lexer/Token.hpp"
+#include "Diagnostics/Diagnostic.hpp"
+#include "Diagnostics/DiagnosticBuffer.hpp"
+#include "Diagnostics/DiagnosticEngine.hpp"
+
+#include "SourceManager/MockSourceManager.hpp"
+
+struct ParallelLexerTestCase {
+    std::string name;
+    std::string source;
+    size_t threadCount;
+    size_t minChunkSize;
+};
+
+class ParallelLexerTest : public testing::Test, public testing::WithParamInterface<ParallelLexerTestCase> {
+protected:
+    MockSourceManager m_sourceManager;
+
+    void SetUp() override {
+        const ParallelLexerTestCase& testcase = GetParam();
+        EXPECT_CALL(m_sourceManager, getBuffer(1)).WillRepeatedly(testing::Return(m_sourceManager.addPaddedBuffer(testcase.source)));
+    }
+};
+
+TEST_P(ParallelLexerTest, MatchesSequentialLexer) {
+    const ParallelLexerTestCase& testcase = GetParam();
+
+    DiagnosticBuffer sequentialDiagnostics;
+    Lexer lexer(1, m_sourceManager, sequentialDiagnostics);
+    std::vector<Token>& expectedTokens = lexer.tokenize();
+
+    DiagnosticBuffer parallelDiagnostics;
+    ParallelLexer parallelLexer(1, m_sourceManager, parallelDiagnostics, testcase.threadCount, testcase.minChunkSize);
+    std::vector<Token>& tokens = parallelLexer.tokenize();
+
+    ASSERT_EQ(tokens.size(), expectedTokens.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        SCOPED_TRACE(testing::Message() << std::format("Token #{}: {}", i, TokenKindToString(expectedTokens[i].kind, lexer.getLexeme(expectedTokens[i]))));
+        EXPECT_EQ(tokens[i].kind, expectedTokens[i].kind);
+        EXPECT_EQ(tokens[i].offset, expectedTokens[i].offset);
+        EXPECT_EQ(tokens[i].length, expectedTokens[i].length);
+        EXPECT_EQ(parallelLexer.getLexeme(tokens[i]), lexer.getLexeme(expectedTokens[i]));
+    }
+
+    auto& expectedDiagnostics = sequentialDiagnostics.getDiagnostics();
+    auto& diagnostics = parallelDiagnostics.getDiagnostics();
+    ASSERT_EQ(diagnostics.size(), expectedDiagnostics.size());
+    for (size_t i = 0; i < diagnostics.size(); ++i) {
+        EXPECT_EQ(diagnostics[i].id, expectedDiagnostics[i].id);
+        EXPECT_EQ(formatMessage(diagnostics[i]), formatMessage(expectedDiagnostics[i]));
+        EXPECT_EQ(diagnostics[i].span.offset, expectedDiagnostics[i].span.offset);
+    }
+}
+
+TEST_P(ParallelLexerTest, TokenizesOnce) {
+    const ParallelLexerTestCase& testcase = GetParam();
+
+    DiagnosticBuffer diagnostics;
+    ParallelLexer parallelLexer(1, m_sourceManager, diagnostics, testcase.threadCount, testcase.minChunkSize);
+    const std::vector<Token> tokens = parallelLexer.tokenize();
+    const size_t spellingCount = parallelLexer.getSpellings().size();
+    const size_t diagnosticCount = diagnostics.getDiagnostics().size();
+
+    std::vector<Token>& again = parallelLexer.tokenize();
+    ASSERT_EQ(again.size(), tokens.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        EXPECT_EQ(again[i].kind, tokens[i].kind);
+        EXPECT_EQ(again[i].offset, tokens[i].offset);
+        EXPECT_EQ(again[i].length, tokens[i].length);
+    }
+    EXPECT_EQ(parallelLexer.getSpellings().size(), spellingCount);
+    EXPECT_EQ(diagnostics.getDiagnostics().size(), diagnosticCount);
+}
+
+// With an error limit both stop at the same error and report the same diagnostics. Chunks after
+// the one reaching the limit are dropped, the stream still ends with EOF
+TEST_P(ParallelLexerTest, StopsAtErrorLimit) {
+    const ParallelLexerTestCase& testcase = GetParam();
+    constexpr size_t ErrorLimit = 5;
+
+    DiagnosticEngine sequentialDiagnostics(m_sourceManager, ErrorLimit);
+    Lexer lexer(1, m_sourceManager, sequentialDiagnostics);
+    std::vector<Token>& expectedTokens = lexer.tokenize();
+
+    DiagnosticEngine parallelDiagnostics(m_sourceManager, ErrorLimit);
+    ParallelLexer parallelLexer(1, m_sourceManager, parallelDiagnostics, testcase.threadCount, testcase.minChunkSize);
+    std::vector<Token>& tokens = parallelLexer.tokenize();
+
+    ASSERT_FALSE(tokens.empty());
+    EXPECT_EQ(tokens.back().kind, TOK_EOF);
+    EXPECT_GE(tokens.size(), expectedTokens.size());
+    EXPECT_EQ(parallelDiagnostics.shouldAbort(), sequentialDiagnostics.shouldAbort());
+
+    std::span<const Diagnostic> expectedDiagnostics = sequentialDiagnostics.getDiagnostics();
+    std::span<const Diagnostic> diagnostics = parallelDiagnostics.getDiagnostics();
+    ASSERT_EQ(diagnostics.size(), expectedDiagnostics.size());
+    for (size_t i = 0; i < diagnostics.size(); ++i) {
+        EXPECT_EQ(diagnostics[i].id, expectedDiagnostics[i].id);
+        EXPECT_EQ(formatMessage(diagnostics[i]), formatMessage(expectedDiagnostics[i]));
+        EXPECT_EQ(diagnostics[i].span.offset, expectedDiagnostics[i].span.offset);
+    }
+    if (sequentialDiagnostics.shouldAbort()) {
+        EXPECT_EQ(expectedDiagnostics.back().id, DiagnosticID::TooManyErrors);
+        EXPECT_LT(expectedTokens.back().offset, m_sourceManager.getBuffer(1).size());
+    }
+}
+
+namespace {
+    std::string repeat(std::string_view snippet, size_t count) {
+        std::string source;
+        for (size_t i = 0; i < count; ++i) {
+            source.append(snippet);
+        }
+        return source;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ParallelLexer,
+    ParallelLexerTest,
+    testing::Values(
+        ParallelLexerTestCase{
+            .name = "EmptySource",
+            .source = "",
+            .threadCount = 4,
+            .minChunkSize = 1
+        },
+
+        ParallelLexerTestCase{
+            .name = "SingleChunk",
+            .source = "let x = 1;\nlet y = 2;\n",
+            .threadCount = 4,
+            .minChunkSize = 1024
+        },
+
+        ParallelLexerTestCase{
+            .name = "ManySmallChunks",
+            .source = repeat("fn main() -> i32 {\n    let value: u64 = 0x1F_u64 << 2;\n    return value;\n}\n", 64),
+            .threadCount = 16,
+            .minChunkSize = 32
+        },
+
+        // Boundaries speculated inside multi-line strings and block comments must be repaired
+        ParallelLexerTestCase{
+            .name = "MultiLineLiteralsAndComments",
+            .source = repeat("let s = \"line one\nline two\n\";\n/* outer\n /* inner\n */\n*/\nx = 'a';\n", 48),
+            .threadCount = 8,
+            .minChunkSize = 16
+        },
+
+        // A raw newline inside a char literal is part of the literal, not a boundary
+        ParallelLexerTestCase{
+            .name = "NewlineInCharLiteral",
+            .source = repeat("let c = '\n';\nlet d = 1;\n", 64),
+            .threadCount = 8,
+            .minChunkSize = 16
+        },
+
+        ParallelLexerTestCase{
+            .name = "DiagnosticsAndUnicode",
+            .source = repeat("let ﬁle = 12abc;\nlet 变量 = $;\n\"unterminated\n", 40),
+            .threadCount = 8,
+            .minChunkSize = 24
+        }
+    ),
+    [](const testing::TestParamInfo<ParallelLexerTestCase>& info) {
+        return info.param.name;
+    }
+);
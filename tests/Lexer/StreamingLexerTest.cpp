@@ -0,0 +1,179 @@
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "CorpusGenerator.hpp"
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/Token.hpp"
+#include "Lexer/StreamingLexer.hpp"
+#include "SourceManager/SourceManager.hpp"
+#include "Diagnostics/DiagnosticBuffer.hpp"
+#include "Diagnostics/DiagnosticEngine.hpp"
+
+struct StreamingTestCase {
+    std::string name;
+    std::string source;
+    size_t chunkSize;
+    size_t writeSize;
+};
+
+class StreamingLexerTest : public testing::TestWithParam<StreamingTestCase> {};
+
+TEST_P(StreamingLexerTest, MatchesFullLex) {
+    const StreamingTestCase& testcase = GetParam();
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    // The producer trickles the source in so chunk boundaries land everywhere
+    std::thread producer([&] {
+        for (size_t offset = 0; offset < testcase.source.size(); offset += testcase.writeSize) {
+            const size_t size = std::min(testcase.writeSize, testcase.source.size() - offset);
+            ASSERT_EQ(write(fds[1], testcase.source.data() + offset, size), static_cast<ssize_t>(size));
+        }
+        close(fds[1]);
+    });
+
+    SourceManager sourceManager;
+    DiagnosticBuffer streamDiagnostics;
+    const ISourceManager::FileID fileID = sourceManager.openStream("<pipe>");
+    StreamingLexer lexer(fileID, sourceManager, streamDiagnostics, fds[0], testcase.chunkSize);
+
+    std::vector<Token> tokens;
+    while (!lexer.isDone()) {
+        for (const Token& token : lexer.lexChunk()) {
+            tokens.push_back(token);
+        }
+    }
+    producer.join();
+    close(fds[0]);
+
+    ASSERT_EQ(sourceManager.getBuffer(fileID), testcase.source);
+    EXPECT_EQ(lexer.tokenize().size(), tokens.size());
+
+    DiagnosticBuffer diagnostics;
+    Lexer fresh(fileID, sourceManager, diagnostics);
+    const std::vector<Token>& expectedTokens = fresh.tokenize();
+
+    ASSERT_EQ(tokens.size(), expectedTokens.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        SCOPED_TRACE(testing::Message() << "Token #" << i);
+        EXPECT_EQ(tokens[i].kind, expectedTokens[i].kind);
+        EXPECT_EQ(tokens[i].offset, expectedTokens[i].offset);
+        EXPECT_EQ(tokens[i].length, expectedTokens[i].length);
+        EXPECT_EQ(lexer.getLexeme(tokens[i]), fresh.getLexeme(expectedTokens[i]));
+    }
+
+    // Diagnostics of tokens that were lexed again must not be reported twice
+    ASSERT_EQ(streamDiagnostics.getDiagnostics().size(), diagnostics.getDiagnostics().size());
+    for (size_t i = 0; i < diagnostics.getDiagnostics().size(); ++i) {
+        EXPECT_EQ(streamDiagnostics.getDiagnostics()[i].id, diagnostics.getDiagnostics()[i].id);
+        EXPECT_EQ(streamDiagnostics.getDiagnostics()[i].span.offset, diagnostics.getDiagnostics()[i].span.offset);
+    }
+}
+
+// An error flood on a stream stops at the engine's limit like a full lex does, instead of
+// buffering every error of a pass
+TEST(StreamingLexerErrorLimitTest, StopsAtErrorLimit) {
+    constexpr size_t ErrorLimit = 3;
+    std::string source;
+    while (source.size() < 8 * 1024) {
+        source += "let x = @ $ 12abc;\n";
+    }
+
+    // Small enough for the pipe buffer, the producer never blocks on a reader that stopped early
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], source.data(), source.size()), static_cast<ssize_t>(source.size()));
+    close(fds[1]);
+
+    SourceManager sourceManager;
+    DiagnosticEngine streamDiagnostics(sourceManager, ErrorLimit);
+    const ISourceManager::FileID fileID = sourceManager.openStream("<pipe>");
+    StreamingLexer lexer(fileID, sourceManager, streamDiagnostics, fds[0], 64);
+    const std::vector<Token>& tokens = lexer.tokenize();
+    close(fds[0]);
+
+    ASSERT_FALSE(tokens.empty());
+    EXPECT_EQ(tokens.back().kind, TOK_EOF);
+    EXPECT_LT(tokens.back().offset, source.size());
+    EXPECT_LT(sourceManager.getBuffer(fileID).size(), source.size());
+
+    DiagnosticEngine diagnostics(sourceManager, ErrorLimit);
+    Lexer fresh(fileID, sourceManager, diagnostics);
+    fresh.tokenize();
+
+    std::span<const Diagnostic> expected = diagnostics.getDiagnostics();
+    std::span<const Diagnostic> actual = streamDiagnostics.getDiagnostics();
+    ASSERT_EQ(actual.size(), ErrorLimit + 1);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i].id, expected[i].id);
+        EXPECT_EQ(actual[i].span.offset, expected[i].span.offset);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    StreamingLexer,
+    StreamingLexerTest,
+    testing::Values(
+        StreamingTestCase{
+            .name = "Empty",
+            .source = "",
+            .chunkSize = 4,
+            .writeSize = 1
+        },
+
+        StreamingTestCase{
+            .name = "ByteAtATime",
+            .source = "let value = a <<= 0x1F + 2.5e10i64; // done\n/* outer /* inner */ */ fn ﬁle() {}\n",
+            .chunkSize = 1,
+            .writeSize = 1
+        },
+
+        StreamingTestCase{
+            .name = "StringsAcrossChunks",
+            .source = "let s = \"a long string with \\n escapes \\u{1F600} spanning reads\"; let c = '\\t';\n",
+            .chunkSize = 3,
+            .writeSize = 5
+        },
+
+        StreamingTestCase{
+            .name = "DiagnosticsAtTheEnd",
+            .source = "let x = 0b102;\nlet y = \"unterminated",
+            .chunkSize = 7,
+            .writeSize = 2
+        },
+
+        StreamingTestCase{
+            .name = "UnterminatedComment",
+            .source = "let a = 1; /* never /* closed */",
+            .chunkSize = 5,
+            .writeSize = 3
+        },
+
+        StreamingTestCase{
+            .name = "GeneratedCorpus",
+            .source = CorpusGenerator({ .seed = 11, .size = 256 * 1024, .unicodeRatio = 0.2, .commentRatio = 0.2 }).generate(),
+            .chunkSize = 4096,
+            .writeSize = 1000
+        },
+
+        StreamingTestCase{
+            .name = "TokenLongerThanChunks",
+            .source = "let s = \"" + std::string(100000, 'x') + "\";\n",
+            .chunkSize = 64,
+            .writeSize = 4096
+        }
+    ),
+    [](const testing::TestParamInfo<StreamingTestCase>& info) {
+        return info.param.name;
+    }
+);
@@ -0,0 +1,165 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <optional>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+#include "Lexer/Lexer.hpp"
+#include "Lexer/ParallelLexer.hpp"
+#include "Lexer/Token.hpp"
+#include "Lexer/TokenCache.hpp"
+#include "Utils/Hash.hpp"
+#include "Diagnostics/DiagnosticBuffer.hpp"
+
+#include "SourceManager/SourceManager.hpp"
+
+class TokenCacheTest : public testing::Test {
+protected:
+    std::filesystem::path m_directory = std::filesystem::temp_directory_path() / "blaze_token_cache";
+    TokenCache m_cache{ m_directory };
+
+    SourceManager m_sourceManager;
+    DiagnosticBuffer m_diagnostics;
+    ISourceManager::FileID m_fileID = 0;
+    // Includes an identifier NFKC changes, so a normalized spelling is stored
+    std::string m_source = "fn main() {\n    let ﬁle = \"text\\n\"; // comment\n    return 0x1F + 2.5;\n}\n";
+
+    void SetUp() override {
+        std::filesystem::remove_all(m_directory);
+        m_sourceManager.addOverlay("cached.bz", m_source);
+        m_fileID = m_sourceManager.loadFile("cached.bz").value();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    // Lexes the source and stores its stream, returning the hash it is keyed by
+    ContentHash storeSource(Lexer& lexer) {
+        const ContentHash hash = m_sourceManager.getContentHash(m_fileID);
+        EXPECT_TRUE(m_cache.store(hash, m_source, lexer.tokenize(), lexer.getSpellings()));
+        return hash;
+    }
+};
+
+TEST_F(TokenCacheTest, RoundTripsTokensAndSpellings) {
+    Lexer lexer(m_fileID, m_sourceManager, m_diagnostics);
+    const ContentHash hash = storeSource(lexer);
+    ASSERT_FALSE(lexer.getSpellings().empty());
+
+    std::optional<CachedTokens> cached = m_cache.load(hash, m_source);
+    ASSERT_TRUE(cached.has_value());
+
+    const std::vector<Token>& tokens = lexer.tokenize();
+    ASSERT_EQ(cached->tokenize().size(), tokens.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        SCOPED_TRACE(testing::Message() << "Token #" << i);
+        const Token& token = cached->tokenize()[i];
+        EXPECT_EQ(token.kind, tokens[i].kind);
+        EXPECT_EQ(token.offset, tokens[i].offset);
+        EXPECT_EQ(token.length, tokens[i].length);
+        EXPECT_EQ(cached->getLexeme(token), lexer.getLexeme(tokens[i]));
+    }
+}
+
+// As the driver does with `-j`, a hit must serve exactly the stream a fresh lex produces
+TEST_F(TokenCacheTest, HitMatchesFreshParallelLex) {
+    ParallelLexer lexer(m_fileID, m_sourceManager, m_diagnostics, 4, 8);
+    const std::vector<Token>& stored = lexer.tokenize();
+    const ContentHash hash = m_sourceManager.getContentHash(m_fileID);
+    ASSERT_TRUE(m_cache.store(hash, m_source, stored, lexer.getSpellings()));
+
+    ParallelLexer fresh(m_fileID, m_sourceManager, m_diagnostics, 4, 8);
+    const std::vector<Token>& tokens = fresh.tokenize();
+    std::optional<CachedTokens> cached = m_cache.load(hash, m_source);
+    ASSERT_TRUE(cached.has_value());
+    ASSERT_EQ(cached->tokenize().size(), tokens.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        SCOPED_TRACE(testing::Message() << "Token #" << i);
+        const Token& token = cached->tokenize()[i];
+        EXPECT_EQ(token.kind, tokens[i].kind);
+        EXPECT_EQ(token.offset, tokens[i].offset);
+        EXPECT_EQ(cached->getLexeme(token), fresh.getLexeme(tokens[i]));
+    }
+}
+
+TEST_F(TokenCacheTest, MissesOnEofBeforeTheEnd) {
+    Lexer lexer(m_fileID, m_sourceManager, m_diagnostics);
+    std::vector<Token> tokens = lexer.tokenize();
+    tokens.insert(tokens.end(), lexer.tokenize().begin(), lexer.tokenize().end());
+    const ContentHash hash = m_sourceManager.getContentHash(m_fileID);
+    ASSERT_TRUE(m_cache.store(hash, m_source, tokens, lexer.getSpellings()));
+
+    EXPECT_FALSE(m_cache.load(hash, m_source).has_value());
+}
+
+TEST_F(TokenCacheTest, MissesWithoutAnEntry) {
+    EXPECT_FALSE(m_cache.load(hash::hashBytes(m_source), m_source).has_value());
+}
+
+TEST_F(TokenCacheTest, MissesForOtherContent) {
+    Lexer lexer(m_fileID, m_sourceManager, m_diagnostics);
+    const ContentHash hash = storeSource(lexer);
+
+    const std::string edited = m_source + "\n";
+    EXPECT_FALSE(m_cache.load(hash::hashBytes(edited), edited).has_value());
+    // Same key but a source of another size, as after a hash collision
+    EXPECT_FALSE(m_cache.load(hash, edited).has_value());
+}
+
+TEST_F(TokenCacheTest, EntriesAreDeterministic) {
+    Lexer lexer(m_fileID, m_sourceManager, m_diagnostics);
+    const ContentHash hash = storeSource(lexer);
+    std::ifstream first(m_cache.getEntryPath(hash), std::ios::binary);
+    const std::string firstBytes{ std::istreambuf_iterator<char>(first), {} };
+
+    Lexer again(m_fileID, m_sourceManager, m_diagnostics);
+    storeSource(again);
+    std::ifstream second(m_cache.getEntryPath(hash), std::ios::binary);
+    EXPECT_EQ(firstBytes, std::string(std::istreambuf_iterator<char>(second), {}));
+}
+
+struct CorruptionTestCase {
+    std::string name;
+    size_t offset;
+    char value;
+    bool truncate;
+};
+
+class TokenCacheCorruptionTest : public TokenCacheTest, public testing::WithParamInterface<CorruptionTestCase> {};
+
+TEST_P(TokenCacheCorruptionTest, MissesOnCorruptEntry) {
+    const CorruptionTestCase& testcase = GetParam();
+    Lexer lexer(m_fileID, m_sourceManager, m_diagnostics);
+    const ContentHash hash = storeSource(lexer);
+    const std::filesystem::path path = m_cache.getEntryPath(hash);
+
+    if (testcase.truncate) {
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - testcase.offset);
+    } else {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(testcase.offset));
+        file.put(testcase.value);
+    }
+
+    EXPECT_FALSE(m_cache.load(hash, m_source).has_value());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TokenCache,
+    TokenCacheCorruptionTest,
+    testing::Values(
+        CorruptionTestCase{ .name = "Magic", .offset = 0, .value = 'X', .truncate = false },
+        CorruptionTestCase{ .name = "LexerVersion", .offset = 8, .value = 99, .truncate = false },
+        CorruptionTestCase{ .name = "HashLow", .offset = 16, .value = 1, .truncate = false },
+        CorruptionTestCase{ .name = "TokenCount", .offset = 40, .value = 3, .truncate = false },
+        // First token's offset, pushed past the end of the source
+        CorruptionTestCase{ .name = "TokenOffset", .offset = 64 + 7, .value = 0x7F, .truncate = false },
+        CorruptionTestCase{ .name = "Truncated", .offset = 1, .value = 0, .truncate = true }
+    ),
+    [](const testing::TestParamInfo<CorruptionTestCase>& info) {
+        return info.param.name;
+    }
+);
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <deque>
+#include <string>
+#include <string_view>
+
 #include <gmock/gmock.h>
 
 #include "SourceManager/SourceManager.hpp"
@@ -13,4 +17,19 @@ public:
     MOCK_METHOD(std::string_view, getBuffer, (ISourceManager::FileID fileID), (const, override));
 
     MOCK_METHOD(std::string_view, getPath, (ISourceManager::FileID fileID), (const, override));
+
+    MOCK_METHOD(const LineTable&, getLineTable, (ISourceManager::FileID fileID), (const, override));
+
+    MOCK_METHOD(ContentHash, getContentHash, (ISourceManager::FileID fileID), (const, override));
+
+    // Copies a test source so it is followed by the NUL padding every ISourceManager buffer has,
+    // return the view from a stubbed getBuffer
+    std::string_view addPaddedBuffer(std::string_view source) {
+        std::string& bytes = m_paddedBuffers.emplace_back(source);
+        bytes.append(SourceBuffer::Padding, '\0');
+        return std::string_view(bytes).substr(0, source.size());
+    }
+
+private:
+    std::deque<std::string> m_paddedBuffers;
 };
@@ -0,0 +1,701 @@
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <utility>
+#include <stdexcept>
+#include <optional>
+#include <filesystem>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "SourceManager/IoUringReader.hpp"
+#include "SourceManager/PathCache.hpp"
+#include "SourceManager/SourceBuffer.hpp"
+#include "SourceManager/SourceManager.hpp"
+#include "Utils/Hash.hpp"
+
+struct SourceBufferTestCase {
+    std::string name;
+    std::string contents;
+    SourceBuffer::Mode mode;
+    bool expectMapped;
+};
+
+class SourceBufferTest : public testing::Test, public testing::WithParamInterface<SourceBufferTestCase> {
+protected:
+    std::filesystem::path m_path;
+
+    void SetUp() override {
+        const SourceBufferTestCase& testcase = GetParam();
+        m_path = std::filesystem::temp_directory_path() / ("blaze_source_buffer_" + testcase.name + ".bz");
+        std::ofstream(m_path, std::ios::binary) << testcase.contents;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(m_path);
+    }
+};
+
+TEST_P(SourceBufferTest, LoadsFileContents) {
+    const SourceBufferTestCase& testcase = GetParam();
+
+    std::optional<SourceBuffer> buffer = SourceBuffer::fromFile(m_path.string(), testcase.mode);
+    ASSERT_TRUE(buffer.has_value());
+    EXPECT_EQ(buffer->view(), testcase.contents);
+    EXPECT_EQ(buffer->isMapped(), testcase.expectMapped);
+
+    // Moving the buffer must not move the bytes, views handed out earlier stay valid
+    std::string_view view = buffer->view();
+    SourceBuffer moved = std::move(buffer.value());
+    EXPECT_EQ(moved.view().data(), view.data());
+    EXPECT_EQ(moved.view(), testcase.contents);
+}
+
+TEST_P(SourceBufferTest, LoadsThroughSourceManager) {
+    const SourceBufferTestCase& testcase = GetParam();
+
+    SourceManager sourceManager(testcase.mode);
+    std::optional<ISourceManager::FileID> fileID = sourceManager.loadFile(m_path.string());
+    ASSERT_TRUE(fileID.has_value());
+    EXPECT_EQ(sourceManager.getBuffer(fileID.value()), testcase.contents);
+    EXPECT_EQ(sourceManager.loadFile(m_path.string()), fileID);
+}
+
+TEST(SourceBufferMissingFileTest, ReturnsNullopt) {
+    EXPECT_FALSE(SourceBuffer::fromFile("/nonexistent/blaze/file.bz").has_value());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SourceBuffer,
+    SourceBufferTest,
+    testing::Values(
+        SourceBufferTestCase{
+            .name = "EmptyFile",
+            .contents = "",
+            .mode = SourceBuffer::Mode::Mapped,
+            .expectMapped = false
+        },
+
+        SourceBufferTestCase{
+            .name = "SmallFileAutoReads",
+            .contents = "let x = 1;\n",
+            .mode = SourceBuffer::Mode::Auto,
+            .expectMapped = false
+        },
+
+        SourceBufferTestCase{
+            .name = "SmallFileMapped",
+            .contents = "let x = 1;\n",
+            .mode = SourceBuffer::Mode::Mapped,
+            .expectMapped = true
+        },
+
+        SourceBufferTestCase{
+            .name = "SmallFileWindowedMaps",
+            .contents = "let x = 1;\n",
+            .mode = SourceBuffer::Mode::Windowed,
+            .expectMapped = true
+        },
+
+        SourceBufferTestCase{
+            .name = "LargeFileAutoMaps",
+            .contents = std::string(SourceBuffer::MapThreshold + 123, 'x'),
+            .mode = SourceBuffer::Mode::Auto,
+            .expectMapped = true
+        },
+
+        SourceBufferTestCase{
+            .name = "LargeFileRead",
+            .contents = std::string(SourceBuffer::MapThreshold + 123, 'y'),
+            .mode = SourceBuffer::Mode::Read,
+            .expectMapped = false
+        }
+    ),
+    [](const testing::TestParamInfo<SourceBufferTestCase>& info) {
+        return info.param.name;
+    }
+);
+
+struct LoadFilesTestCase {
+    std::string name;
+    SourceBuffer::Mode mode;
+    BatchLoadOptions options;
+};
+
+class LoadFilesTest : public testing::Test, public testing::WithParamInterface<LoadFilesTestCase> {
+protected:
+    std::filesystem::path m_directory;
+    std::vector<std::string> m_paths;
+
+    void SetUp() override {
+        m_directory = std::filesystem::temp_directory_path() / ("blaze_load_files_" + GetParam().name);
+        std::filesystem::create_directories(m_directory);
+
+        // A mix of empty, small and mapped-size files, with duplicates and a missing path
+        for (size_t i = 0; i < 24; ++i) {
+            const std::filesystem::path path = m_directory / ("module" + std::to_string(i) + ".bz");
+            const size_t size = i % 6 == 0 ? 0 : (i % 5 == 0 ? SourceBuffer::MapThreshold * 2 : i * 37);
+            std::ofstream(path, std::ios::binary) << std::string(size, static_cast<char>('a' + i % 26));
+            m_paths.push_back(path.string());
+        }
+        m_paths.push_back(m_paths[3]);
+        m_paths.push_back((m_directory / "." / "module7.bz").string());
+        m_paths.push_back((m_directory / "missing.bz").string());
+        m_paths.push_back(m_paths[0]);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_directory);
+    }
+};
+
+TEST_P(LoadFilesTest, MatchesSerialLoadFile) {
+    const LoadFilesTestCase& testcase = GetParam();
+
+    SourceManager serial(testcase.mode);
+    std::vector<std::optional<ISourceManager::FileID>> expectedIDs;
+    for (const std::string& path : m_paths) {
+        expectedIDs.push_back(serial.loadFile(path));
+    }
+
+    SourceManager batched(testcase.mode);
+    std::vector<std::optional<ISourceManager::FileID>> fileIDs = batched.loadFiles(m_paths, testcase.options);
+
+    ASSERT_EQ(fileIDs, expectedIDs);
+    for (const std::optional<ISourceManager::FileID>& fileID : fileIDs) {
+        if (fileID.has_value()) {
+            EXPECT_EQ(batched.getBuffer(fileID.value()), serial.getBuffer(fileID.value()));
+            EXPECT_EQ(batched.getPath(fileID.value()), serial.getPath(fileID.value()));
+            EXPECT_EQ(batched.getLineTable(fileID.value()).getLineCount(), serial.getLineTable(fileID.value()).getLineCount());
+        }
+    }
+
+    // A second batch only returns the existing IDs
+    EXPECT_EQ(batched.loadFiles(m_paths, testcase.options), expectedIDs);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SourceManager,
+    LoadFilesTest,
+    testing::Values(
+        LoadFilesTestCase{
+            .name = "SingleThread",
+            .mode = SourceBuffer::Mode::Auto,
+            .options = { .threadCount = 1, .useIoUring = false }
+        },
+
+        LoadFilesTestCase{
+            .name = "ThreadPoolRead",
+            .mode = SourceBuffer::Mode::Read,
+            .options = { .threadCount = 8, .useIoUring = false }
+        },
+
+        LoadFilesTestCase{
+            .name = "IoUringRead",
+            .mode = SourceBuffer::Mode::Read,
+            .options = { .threadCount = 4, .useIoUring = true }
+        },
+
+        LoadFilesTestCase{
+            .name = "Mapped",
+            .mode = SourceBuffer::Mode::Mapped,
+            .options = { .threadCount = 4 }
+        }
+    ),
+    [](const testing::TestParamInfo<LoadFilesTestCase>& info) {
+        return info.param.name;
+    }
+);
+
+TEST(IoUringReaderTest, ReadsRequestsToCompletion) {
+    IoUringReader reader(4);
+    if (!reader.isValid()) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "blaze_io_uring_reader.bz";
+    const std::string contents(100000, 'z');
+    std::ofstream(path, std::ios::binary) << contents;
+
+    // More requests than ring entries, so completions have to make room for the rest
+    std::vector<SourceBuffer> buffers;
+    std::vector<IoUringReader::Request> requests;
+    for (size_t i = 0; i < 10; ++i) {
+        int fd = -1;
+        std::optional<SourceBuffer> buffer = SourceBuffer::prepare(path.string(), SourceBuffer::Mode::Read, fd);
+        ASSERT_TRUE(buffer.has_value());
+        ASSERT_GE(fd, 0);
+        buffers.push_back(std::move(buffer.value()));
+        requests.push_back({ .fd = fd, .data = buffers.back().fillData(), .size = buffers.back().size() });
+    }
+
+    EXPECT_TRUE(reader.readAll(requests));
+    for (size_t i = 0; i < requests.size(); ++i) {
+        EXPECT_FALSE(requests[i].failed);
+        EXPECT_EQ(std::string_view(requests[i].data, requests[i].done), contents);
+        SourceBuffer::closeFile(requests[i].fd);
+    }
+    std::filesystem::remove(path);
+}
+
+class WindowedTest : public testing::Test {
+protected:
+    std::filesystem::path m_path = std::filesystem::temp_directory_path() / "blaze_windowed.bz";
+    std::string m_contents;
+
+    void SetUp() override {
+        // Several pages of lines, so eviction has whole pages to drop
+        for (size_t i = 0; i < 4000; ++i) {
+            m_contents += "let value" + std::to_string(i) + " = " + std::to_string(i * 7) + ";\n";
+        }
+        std::ofstream(m_path, std::ios::binary) << m_contents;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(m_path);
+    }
+};
+
+TEST_F(WindowedTest, IndexesLikeAFullLoad) {
+    SourceManager full;
+    SourceManager windowed(SourceBuffer::Mode::Windowed);
+    const ISourceManager::FileID fullID = full.loadFile(m_path.string()).value();
+    const ISourceManager::FileID windowedID = windowed.loadFiles(std::vector<std::string>{ m_path.string() })[0].value();
+
+    EXPECT_EQ(windowed.getBuffer(windowedID), m_contents);
+    const LineTable& expected = full.getLineTable(fullID);
+    const LineTable& lineTable = windowed.getLineTable(windowedID);
+    ASSERT_EQ(lineTable.getLineCount(), expected.getLineCount());
+    for (size_t line = 1; line <= expected.getLineCount(); ++line) {
+        ASSERT_EQ(lineTable.getLineStart(line), expected.getLineStart(line)) << "line " << line;
+    }
+
+    // Not fingerprinted while loading, but on demand the hash is the same
+    EXPECT_EQ(windowed.getContentHash(windowedID), full.getContentHash(fullID));
+}
+
+TEST_F(WindowedTest, EvictedPagesReadBackFromTheFile) {
+    SourceManager sourceManager(SourceBuffer::Mode::Windowed);
+    const ISourceManager::FileID fileID = sourceManager.loadFile(m_path.string()).value();
+    const std::string_view buffer = sourceManager.getBuffer(fileID);
+
+    sourceManager.evict(fileID, 0, buffer.size());
+    EXPECT_EQ(buffer, m_contents);
+    sourceManager.evict(fileID, 100, buffer.size() / 2);
+    EXPECT_EQ(buffer, m_contents);
+    EXPECT_EQ(sourceManager.getBuffer(fileID).data(), buffer.data());
+}
+
+TEST_F(WindowedTest, IsNotShared) {
+    const std::filesystem::path copy = m_path.string() + ".copy";
+    std::filesystem::copy_file(m_path, copy, std::filesystem::copy_options::overwrite_existing);
+
+    SourceManager sourceManager(SourceBuffer::Mode::Windowed, true);
+    const ISourceManager::FileID first = sourceManager.loadFile(m_path.string()).value();
+    const ISourceManager::FileID second = sourceManager.loadFile(copy.string()).value();
+    EXPECT_NE(sourceManager.getBuffer(first).data(), sourceManager.getBuffer(second).data());
+    EXPECT_EQ(sourceManager.getBuffer(first), sourceManager.getBuffer(second));
+
+    std::filesystem::remove(copy);
+}
+
+class PathCacheTest : public testing::Test {
+protected:
+    std::filesystem::path m_directory = std::filesystem::temp_directory_path() / "blaze_path_cache";
+
+    void SetUp() override {
+        std::filesystem::create_directories(m_directory / "a");
+        std::filesystem::create_directories(m_directory / "b");
+        std::ofstream(m_directory / "a" / "module.bz") << "let a = 1;\n";
+        std::ofstream(m_directory / "b" / "module.bz") << "let b = 2;\n";
+        std::filesystem::create_directory_symlink(m_directory / "a", m_directory / "current");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::string canonical(const std::string& path) {
+        return std::filesystem::canonical(path).string();
+    }
+};
+
+TEST_F(PathCacheTest, MemoizesCanonicalPaths) {
+    PathCache pathCache;
+    const std::string path = (m_directory / "current" / ".." / "current" / "module.bz").string();
+
+    EXPECT_EQ(pathCache.canonicalize(path), canonical(path));
+    EXPECT_EQ(pathCache.canonicalize(path), canonical(path));
+    EXPECT_EQ(pathCache.getMissCount(), 1);
+    EXPECT_EQ(pathCache.getHitCount(), 1);
+}
+
+TEST_F(PathCacheTest, RepointedSymlinkMisses) {
+    PathCache pathCache;
+    const std::string path = (m_directory / "current" / "module.bz").string();
+    EXPECT_EQ(pathCache.canonicalize(path), (std::filesystem::canonical(m_directory) / "a" / "module.bz").string());
+
+    std::filesystem::remove(m_directory / "current");
+    std::filesystem::create_directory_symlink(m_directory / "b", m_directory / "current");
+    EXPECT_EQ(pathCache.canonicalize(path), (std::filesystem::canonical(m_directory) / "b" / "module.bz").string());
+    EXPECT_EQ(pathCache.getHitCount(), 0);
+}
+
+TEST_F(PathCacheTest, ModifiedFileMisses) {
+    PathCache pathCache;
+    const std::filesystem::path path = m_directory / "a" / "module.bz";
+    pathCache.canonicalize(path.string());
+
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(5));
+    EXPECT_EQ(pathCache.canonicalize(path.string()), canonical(path.string()));
+    EXPECT_EQ(pathCache.getMissCount(), 2);
+}
+
+TEST_F(PathCacheTest, MissingPathsAreNotCached) {
+    PathCache pathCache;
+    const std::filesystem::path path = m_directory / "a" / "later.bz";
+    EXPECT_FALSE(pathCache.canonicalize(path.string()).has_value());
+
+    std::ofstream(path) << "let later = 3;\n";
+    EXPECT_EQ(pathCache.canonicalize(path.string()), canonical(path.string()));
+}
+
+TEST_F(PathCacheTest, SharedAcrossSourceManagers) {
+    std::shared_ptr<PathCache> pathCache = std::make_shared<PathCache>();
+    const std::string path = (m_directory / "current" / "module.bz").string();
+
+    for (int i = 0; i < 3; ++i) {
+        SourceManager sourceManager(SourceBuffer::Mode::Auto, false, pathCache);
+        std::optional<ISourceManager::FileID> fileID = sourceManager.loadFile(path);
+        ASSERT_TRUE(fileID.has_value());
+        EXPECT_EQ(sourceManager.getPath(fileID.value()), canonical(path));
+        EXPECT_EQ(sourceManager.loadFiles(std::vector<std::string>{ path })[0], fileID);
+    }
+    EXPECT_EQ(pathCache->getMissCount(), 1);
+}
+
+class SharedContentTest : public testing::Test {
+protected:
+    std::filesystem::path m_directory = std::filesystem::temp_directory_path() / "blaze_shared_content";
+    std::vector<std::string> m_paths;
+
+    void SetUp() override {
+        std::filesystem::create_directories(m_directory);
+        const std::string contents[] = { "let x = 1;\n", "let y = 2;\n", "let x = 1;\n", "" , "" };
+        for (size_t i = 0; i < std::size(contents); ++i) {
+            const std::filesystem::path path = m_directory / ("vendored" + std::to_string(i) + ".bz");
+            std::ofstream(path, std::ios::binary) << contents[i];
+            m_paths.push_back(path.string());
+        }
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_directory);
+    }
+};
+
+TEST_F(SharedContentTest, IdenticalFilesHaveEqualHashes) {
+    SourceManager sourceManager;
+    std::vector<std::optional<ISourceManager::FileID>> fileIDs = sourceManager.loadFiles(m_paths);
+
+    EXPECT_EQ(sourceManager.getContentHash(fileIDs[0].value()), sourceManager.getContentHash(fileIDs[2].value()));
+    EXPECT_NE(sourceManager.getContentHash(fileIDs[0].value()), sourceManager.getContentHash(fileIDs[1].value()));
+    EXPECT_EQ(sourceManager.getContentHash(fileIDs[0].value()), hash::hashBytes("let x = 1;\n"));
+
+    // Without sharing every file keeps its own buffer
+    EXPECT_NE(sourceManager.getBuffer(fileIDs[0].value()).data(), sourceManager.getBuffer(fileIDs[2].value()).data());
+}
+
+TEST_F(SharedContentTest, SharesIdenticalBuffers) {
+    SourceManager sourceManager(SourceBuffer::Mode::Auto, true);
+    std::vector<std::optional<ISourceManager::FileID>> fileIDs;
+    for (const std::string& path : m_paths) {
+        fileIDs.push_back(sourceManager.loadFile(path));
+    }
+
+    // Distinct FileIDs and paths, one buffer and line table
+    ASSERT_NE(fileIDs[0], fileIDs[2]);
+    EXPECT_NE(sourceManager.getPath(fileIDs[0].value()), sourceManager.getPath(fileIDs[2].value()));
+    EXPECT_EQ(sourceManager.getBuffer(fileIDs[0].value()).data(), sourceManager.getBuffer(fileIDs[2].value()).data());
+    EXPECT_EQ(&sourceManager.getLineTable(fileIDs[0].value()), &sourceManager.getLineTable(fileIDs[2].value()));
+    EXPECT_NE(sourceManager.getBuffer(fileIDs[0].value()).data(), sourceManager.getBuffer(fileIDs[1].value()).data());
+    EXPECT_EQ(&sourceManager.getLineTable(fileIDs[3].value()), &sourceManager.getLineTable(fileIDs[4].value()));
+}
+
+class ApplyEditTest : public testing::Test {
+protected:
+    std::filesystem::path m_directory = std::filesystem::temp_directory_path() / "blaze_apply_edit";
+
+    std::string writeFile(const std::string& name, const std::string& contents) {
+        std::filesystem::create_directories(m_directory);
+        const std::filesystem::path path = m_directory / name;
+        std::ofstream(path, std::ios::binary) << contents;
+        return path.string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_directory);
+    }
+};
+
+TEST_F(ApplyEditTest, PatchesBufferLineTableAndHash) {
+    SourceManager sourceManager(SourceBuffer::Mode::Mapped);
+    ISourceManager::FileID fileID = sourceManager.loadFile(writeFile("edit.bz", "let a = 1;\nlet b = 2;\nlet c = 3;\n")).value();
+
+    std::string expected = "let a = 1;\nlet b = 2;\nlet c = 3;\n";
+    const std::pair<SourceRange, std::string> edits[] = {
+        { { 4, 1 }, "alpha" },
+        { { 11, 0 }, "// one\n// two\n" },
+        { { 0, 15 }, "" },
+        { { 0, 0 }, "\n\n" },
+    };
+
+    for (const auto& [range, text] : edits) {
+        SourceEdit edit = sourceManager.applyEdit(fileID, range, text);
+        expected.replace(range.offset, range.length, text);
+
+        EXPECT_EQ(edit.insertedLength, text.size());
+        EXPECT_EQ(sourceManager.getBuffer(fileID), expected);
+        EXPECT_EQ(sourceManager.getContentHash(fileID), hash::hashBytes(expected));
+
+        // The patched table answers exactly like one built from scratch
+        const LineTable rebuilt(expected);
+        const LineTable& lineTable = sourceManager.getLineTable(fileID);
+        ASSERT_EQ(lineTable.getLineCount(), rebuilt.getLineCount());
+        for (size_t offset = 0; offset <= expected.size(); ++offset) {
+            EXPECT_EQ(lineTable.getLineColumn(offset), rebuilt.getLineColumn(offset)) << offset;
+        }
+    }
+}
+
+TEST_F(ApplyEditTest, CopiesSharedBuffersOnWrite) {
+    SourceManager sourceManager(SourceBuffer::Mode::Auto, true);
+    sourceManager.addOverlay("a.bz", "let x = 1;\n");
+    sourceManager.addOverlay("b.bz", "let x = 1;\n");
+    ISourceManager::FileID first = sourceManager.loadFile("a.bz").value();
+    ISourceManager::FileID second = sourceManager.loadFile("b.bz").value();
+    ASSERT_EQ(sourceManager.getBuffer(first).data(), sourceManager.getBuffer(second).data());
+
+    sourceManager.applyEdit(second, { 4, 1 }, "y");
+    EXPECT_EQ(sourceManager.getBuffer(first), "let x = 1;\n");
+    EXPECT_EQ(sourceManager.getBuffer(second), "let y = 1;\n");
+    EXPECT_NE(sourceManager.getContentHash(first), sourceManager.getContentHash(second));
+}
+
+// Empty buffers have no storage of their own, editing them must not write through a null pointer
+TEST_F(ApplyEditTest, EditsEmptyBuffers) {
+    SourceManager sourceManager;
+    sourceManager.addOverlay("empty.bz", "");
+    ISourceManager::FileID fileID = sourceManager.loadFile("empty.bz").value();
+
+    sourceManager.applyEdit(fileID, { 0, 0 }, "");
+    EXPECT_EQ(sourceManager.getBuffer(fileID), "");
+    EXPECT_EQ(sourceManager.getBuffer(fileID).data()[0], '\0');
+
+    sourceManager.applyEdit(fileID, { 0, 0 }, "x");
+    EXPECT_EQ(sourceManager.getBuffer(fileID), "x");
+    sourceManager.applyEdit(fileID, { 0, 1 }, "");
+    EXPECT_EQ(sourceManager.getBuffer(fileID), "");
+}
+
+TEST_F(ApplyEditTest, CopiesSharedEmptyBuffersOnWrite) {
+    SourceManager sourceManager(SourceBuffer::Mode::Auto, true);
+    sourceManager.addOverlay("a.bz", "");
+    sourceManager.addOverlay("b.bz", "");
+    ISourceManager::FileID first = sourceManager.loadFile("a.bz").value();
+    ISourceManager::FileID second = sourceManager.loadFile("b.bz").value();
+
+    sourceManager.applyEdit(second, { 0, 0 }, "");
+    EXPECT_EQ(sourceManager.getBuffer(second), "");
+    sourceManager.applyEdit(second, { 0, 0 }, "let");
+    EXPECT_EQ(sourceManager.getBuffer(first), "");
+    EXPECT_EQ(sourceManager.getBuffer(second), "let");
+}
+
+TEST_F(ApplyEditTest, RejectsRangesOutsideTheBuffer) {
+    SourceManager sourceManager;
+    sourceManager.addOverlay("short.bz", "abc");
+    ISourceManager::FileID fileID = sourceManager.loadFile("short.bz").value();
+    EXPECT_THROW(sourceManager.applyEdit(fileID, { 2, 2 }, "x"), std::out_of_range);
+    EXPECT_THROW(sourceManager.applyEdit(fileID, { 4, 0 }, "x"), std::out_of_range);
+    EXPECT_NO_THROW(sourceManager.applyEdit(fileID, { 3, 0 }, "d"));
+    EXPECT_EQ(sourceManager.getBuffer(fileID), "abcd");
+}
+
+TEST(SourceManagerStreamTest, ReadsPipeInChunks) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const std::string contents = "let a = 1;\nlet b = 2;\n\nlet c = 3;";
+    ASSERT_EQ(write(fds[1], contents.data(), contents.size()), static_cast<ssize_t>(contents.size()));
+    close(fds[1]);
+
+    SourceManager sourceManager;
+    const ISourceManager::FileID fileID = sourceManager.openStream("<stdin>");
+    EXPECT_EQ(sourceManager.getPath(fileID), "<stdin>");
+    EXPECT_EQ(sourceManager.getBuffer(fileID), "");
+
+    size_t total = 0;
+    while (std::optional<size_t> count = sourceManager.readStream(fileID, fds[0], 4)) {
+        if (count.value() == 0) {
+            break;
+        }
+        EXPECT_LE(count.value(), 4u);
+        total += count.value();
+    }
+    close(fds[0]);
+
+    EXPECT_EQ(total, contents.size());
+    EXPECT_EQ(sourceManager.getBuffer(fileID), contents);
+    EXPECT_EQ(sourceManager.getContentHash(fileID), hash::hashBytes(contents));
+
+    const LineTable rebuilt(contents);
+    ASSERT_EQ(sourceManager.getLineTable(fileID).getLineCount(), rebuilt.getLineCount());
+    for (size_t offset = 0; offset <= contents.size(); ++offset) {
+        EXPECT_EQ(sourceManager.getLineTable(fileID).getLineColumn(offset), rebuilt.getLineColumn(offset));
+    }
+}
+
+class OverlayTest : public testing::Test {
+protected:
+    std::filesystem::path m_directory = std::filesystem::temp_directory_path() / "blaze_overlay";
+
+    void SetUp() override {
+        std::filesystem::create_directories(m_directory);
+        std::ofstream(m_directory / "disk.bz", std::ios::binary) << "let onDisk = 1;";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_directory);
+    }
+};
+
+TEST_F(OverlayTest, LoadsVirtualPathsWithoutTouchingDisk) {
+    SourceManager sourceManager;
+    const std::string path = (m_directory / "virtual" / "gen.bz").string();
+    sourceManager.addOverlay(path, "let generated = 2;\n");
+
+    std::optional<ISourceManager::FileID> fileID = sourceManager.loadFile(path);
+    ASSERT_TRUE(fileID.has_value());
+    EXPECT_EQ(sourceManager.getBuffer(*fileID), "let generated = 2;\n");
+    EXPECT_EQ(sourceManager.getPath(*fileID), path);
+    EXPECT_EQ(sourceManager.getLineTable(*fileID).getLineCount(), 2u);
+    EXPECT_EQ(sourceManager.getContentHash(*fileID), hash::hashBytes("let generated = 2;\n"));
+    EXPECT_FALSE(std::filesystem::exists(m_directory / "virtual"));
+
+    // Other spellings of the same path resolve to the same file
+    EXPECT_EQ(sourceManager.loadFile((m_directory / "virtual" / ".." / "virtual" / "gen.bz").string()), fileID);
+    EXPECT_EQ(sourceManager.loadFile(path), fileID);
+}
+
+TEST_F(OverlayTest, ShadowsFilesOnDisk) {
+    SourceManager sourceManager;
+    const std::string path = (m_directory / "disk.bz").string();
+    sourceManager.addOverlay(path, "let unsaved = 3;");
+
+    std::optional<ISourceManager::FileID> fileID = sourceManager.loadFile(path);
+    ASSERT_TRUE(fileID.has_value());
+    EXPECT_EQ(sourceManager.getBuffer(*fileID), "let unsaved = 3;");
+}
+
+// Overlaying a path that is already loaded must not hand out a second FileID for it
+TEST_F(OverlayTest, RejectsPathsAlreadyLoaded) {
+    SourceManager sourceManager;
+    const std::string diskPath = std::filesystem::canonical(m_directory / "disk.bz").string();
+    const ISourceManager::FileID diskID = sourceManager.loadFile(diskPath).value();
+    EXPECT_FALSE(sourceManager.addOverlay(diskPath, "let unsaved = 3;"));
+    EXPECT_EQ(sourceManager.loadFile(diskPath), diskID);
+    EXPECT_EQ(sourceManager.getBuffer(diskID), "let onDisk = 1;");
+
+    const std::string virtualPath = (m_directory / "gen.bz").string();
+    EXPECT_TRUE(sourceManager.addOverlay(virtualPath, "let first = 1;"));
+    const ISourceManager::FileID virtualID = sourceManager.loadFile(virtualPath).value();
+    EXPECT_FALSE(sourceManager.addOverlay(virtualPath, "let second = 2;"));
+    EXPECT_EQ(sourceManager.loadFile(virtualPath), virtualID);
+    EXPECT_EQ(sourceManager.getBuffer(virtualID), "let first = 1;");
+}
+
+TEST_F(OverlayTest, LoadFilesMixesOverlaysAndDisk) {
+    SourceManager sourceManager;
+    const std::string virtualPath = (m_directory / "virtual.bz").string();
+    const std::string diskPath = (m_directory / "disk.bz").string();
+    const std::string missingPath = (m_directory / "missing.bz").string();
+    sourceManager.addOverlay(virtualPath, "let inMemory = 4;");
+
+    const std::vector<std::string> paths = { diskPath, virtualPath, missingPath, virtualPath };
+    std::vector<std::optional<ISourceManager::FileID>> fileIDs = sourceManager.loadFiles(paths);
+
+    ASSERT_EQ(fileIDs.size(), 4u);
+    EXPECT_EQ(fileIDs[0], 0);
+    EXPECT_EQ(fileIDs[1], 1);
+    EXPECT_FALSE(fileIDs[2].has_value());
+    EXPECT_EQ(fileIDs[3], 1);
+    EXPECT_EQ(sourceManager.getBuffer(0), "let onDisk = 1;");
+    EXPECT_EQ(sourceManager.getBuffer(1), "let inMemory = 4;");
+}
+
+// Every buffer must be followed by SourceBuffer::Padding NUL bytes, however it was produced
+void ExpectPadded(const SourceBuffer& buffer) {
+    const char* end = buffer.view().data() + buffer.size();
+    for (size_t i = 0; i < SourceBuffer::Padding; ++i) {
+        ASSERT_EQ(end[i], '\0') << "padding byte " << i << " of a " << buffer.size() << " byte buffer";
+    }
+}
+
+class SourceBufferPaddingTest : public testing::TestWithParam<SourceBuffer::Mode> {
+protected:
+    std::filesystem::path m_path = std::filesystem::temp_directory_path() / "blaze_padding.bz";
+
+    void TearDown() override {
+        std::filesystem::remove(m_path);
+    }
+};
+
+TEST_P(SourceBufferPaddingTest, FilesAreFollowedByPadding) {
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    // Sizes around page boundaries, where a mapping would otherwise end right after the data
+    for (size_t size : { size_t(1), size_t(100), pageSize - SourceBuffer::Padding, pageSize - 1, pageSize, pageSize + 1, 3 * pageSize }) {
+        SCOPED_TRACE(testing::Message() << size << " bytes");
+        std::ofstream(m_path, std::ios::binary | std::ios::trunc) << std::string(size, 'x');
+
+        std::optional<SourceBuffer> buffer = SourceBuffer::fromFile(m_path.string(), GetParam());
+        ASSERT_TRUE(buffer.has_value());
+        EXPECT_EQ(buffer->view(), std::string(size, 'x'));
+        ExpectPadded(*buffer);
+
+        buffer->replace(size / 2, 1, "edited");
+        ExpectPadded(*buffer);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SourceBuffer,
+    SourceBufferPaddingTest,
+    testing::Values(SourceBuffer::Mode::Mapped, SourceBuffer::Mode::Read),
+    [](const testing::TestParamInfo<SourceBuffer::Mode>& info) {
+        return info.param == SourceBuffer::Mode::Mapped ? "Mapped" : "Read";
+    }
+);
+
+TEST(SourceBufferTest, InMemoryBuffersAreFollowedByPadding) {
+    ExpectPadded(SourceBuffer());
+    ExpectPadded(SourceBuffer::fromBytes(""));
+
+    SourceBuffer buffer = SourceBuffer::fromBytes("let a = 1;");
+    ExpectPadded(buffer);
+    buffer.replace(0, 10, "");
+    ExpectPadded(buffer);
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], "abcdef", 6), 6);
+    close(fds[1]);
+    while (buffer.readAppend(fds[0], 4).value_or(0) > 0) {
+        ExpectPadded(buffer);
+    }
+    close(fds[0]);
+    EXPECT_EQ(buffer.view(), "abcdef");
+}
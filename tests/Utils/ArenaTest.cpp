@@ -0,0 +1,52 @@
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "Utils/Arena.hpp"
+
+TEST(ArenaTest, CopiesOutliveTheSource) {
+    Arena arena;
+    std::vector<std::string_view> copies;
+    for (int i = 0; i < 1000; ++i) {
+        const std::string text = "message number " + std::to_string(i);
+        copies.push_back(arena.copyString(text));
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(copies[i], "message number " + std::to_string(i));
+    }
+    EXPECT_TRUE(arena.copyString("").empty());
+}
+
+TEST(ArenaTest, RespectsAlignment) {
+    Arena arena;
+    for (size_t alignment : { 1, 2, 8, 16, 64 }) {
+        arena.allocate(3, 1);
+        void* pointer = arena.allocate(8, alignment);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(pointer) % alignment, 0u) << alignment;
+    }
+}
+
+// A request larger than a whole block gets its own block, the current block keeps filling
+TEST(ArenaTest, OversizedAllocationsKeepTheCurrentBlock) {
+    Arena arena;
+    char* first = static_cast<char*>(arena.allocate(16, 1));
+    const std::string big(Arena::MaxBlockSize * 2, 'x');
+    EXPECT_EQ(arena.copyString(big), big);
+    char* second = static_cast<char*>(arena.allocate(16, 1));
+    EXPECT_EQ(second, first + 16);
+}
+
+TEST(ArenaTest, MovedArenaKeepsAddresses) {
+    Arena arena;
+    std::string_view copy = arena.copyString("kept across the move");
+    Arena moved = std::move(arena);
+    EXPECT_EQ(copy, "kept across the move");
+
+    moved.reset();
+    EXPECT_EQ(moved.getCapacity(), 0u);
+    EXPECT_EQ(moved.copyString("after reset"), "after reset");
+}
@@ -0,0 +1,43 @@
+#include <string>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include "Utils/Hash.hpp"
+
+TEST(HashTest, IsDeterministic) {
+    const std::string bytes = "fn main() -> i32 { return 0; }\n";
+    EXPECT_EQ(hash::hashBytes(bytes), hash::hashBytes(std::string(bytes)));
+    EXPECT_NE(hash::hashBytes(bytes, 1), hash::hashBytes(bytes, 2));
+}
+
+// Every prefix of a buffer, including ones differing only in trailing zero bytes, is distinct
+TEST(HashTest, LengthsAndZeroPaddingDiffer) {
+    const std::string bytes(200, '\0');
+    std::unordered_set<std::string> seen;
+    for (size_t length = 0; length <= bytes.size(); ++length) {
+        EXPECT_TRUE(seen.insert(hash::hashBytes(std::string_view(bytes).substr(0, length)).toString()).second) << length;
+    }
+}
+
+TEST(HashTest, SingleBitFlipsDiffer) {
+    std::string bytes(97, 'x');
+    const ContentHash original = hash::hashBytes(bytes);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        for (int bit = 0; bit < 8; ++bit) {
+            bytes[i] ^= static_cast<char>(1 << bit);
+            EXPECT_NE(hash::hashBytes(bytes), original) << "byte " << i << " bit " << bit;
+            bytes[i] ^= static_cast<char>(1 << bit);
+        }
+    }
+}
+
+TEST(HashTest, IndependentOfAlignment) {
+    const std::string storage = "_abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJ";
+    EXPECT_EQ(hash::hashBytes(std::string_view(storage).substr(1)), hash::hashBytes(storage.substr(1)));
+}
+
+TEST(HashTest, ToStringIsHex) {
+    const ContentHash hash = { .low = 0x0123456789abcdefull, .high = 0xfedcba9876543210ull };
+    EXPECT_EQ(hash.toString(), "fedcba98765432100123456789abcdef");
+}
@@ -0,0 +1,18 @@
+#include <gtest/gtest.h>
+#include <unicode/uchar.h>
+
+#include "Utils/Unicode.hpp"
+
+// The generated tables must agree with ICU on every codepoint
+TEST(UnicodeTest, XIDTablesMatchICU) {
+    for (char32_t cp = 0; cp <= unicode::MaxCodepoint; ++cp) {
+        const UChar32 icuCodepoint = static_cast<UChar32>(cp);
+        ASSERT_EQ(unicode::isXIDStart(cp), static_cast<bool>(u_hasBinaryProperty(icuCodepoint, UCHAR_XID_START))) << std::hex << "U+" << static_cast<uint32_t>(cp);
+        ASSERT_EQ(unicode::isXIDContinue(cp), static_cast<bool>(u_hasBinaryProperty(icuCodepoint, UCHAR_XID_CONTINUE))) << std::hex << "U+" << static_cast<uint32_t>(cp);
+    }
+}
+
+TEST(UnicodeTest, OutOfRangeIsNotIdentifier) {
+    EXPECT_FALSE(unicode::isXIDStart(unicode::MaxCodepoint + 1));
+    EXPECT_FALSE(unicode::isXIDContinue(0xFFFFFFFF));
+}
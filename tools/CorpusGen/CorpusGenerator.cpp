@@ -0,0 +1,352 @@
+#include "CorpusGenerator.hpp"
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include <string_view>
+
+namespace {
+    constexpr std::array<std::string_view, 16> kAsciiStems = {
+        "count", "index", "value", "buffer", "offset", "length", "result", "node",
+        "left", "right", "total", "cursor", "limit", "scale", "state", "entry",
+    };
+
+    constexpr std::array<std::string_view, 12> kUnicodeStems = {
+        "größe", "länge", "fläche", "straße", "名前", "変数",
+        "значение", "счётчик", "δύναμη", "λόγος", "café", "ñandú",
+    };
+
+    constexpr std::array<std::string_view, 10> kTypes = {
+        "u8", "u16", "u32", "u64", "i32", "i64", "f32", "f64", "bool", "string",
+    };
+
+    constexpr std::array<std::string_view, 14> kBinaryOperators = {
+        "+", "-", "*", "/", "%", "<<", ">>", "&", "|", "^", "&&", "||", "==", "<=",
+    };
+
+    constexpr std::array<std::string_view, 6> kAssignOperators = {
+        "=", "+=", "-=", "*=", "<<=", "|=",
+    };
+
+    constexpr std::array<std::string_view, 8> kAsciiWords = {
+        "alpha", "beta", "gamma", "delta", "error", "done", "ready", "value",
+    };
+
+    constexpr std::array<std::string_view, 8> kUnicodeWords = {
+        "grüße", "こんにちは", "世界", "привет", "καλημέρα", "año", "naïve", "😀",
+    };
+
+    constexpr std::array<std::string_view, 6> kEscapes = {
+        "\\n", "\\t", "\\\\", "\\\"", "\\x41", "\\0",
+    };
+
+    constexpr std::array<std::string_view, 6> kAsciiChars = {
+        "a", "Z", "0", "\\n", "\\'", "\\\\",
+    };
+
+    constexpr std::array<std::string_view, 4> kUnicodeChars = {
+        "é", "ß", "字", "λ",
+    };
+
+    constexpr int MaxExpressionDepth = 3;
+    constexpr int MaxStatementDepth = 2;
+}
+
+CorpusGenerator::CorpusGenerator(const CorpusOptions& options)
+:   m_options(options),
+    m_state(options.seed) {}
+
+// SplitMix64, specified here rather than taken from <random> so output is identical on every standard library
+uint64_t CorpusGenerator::nextRandom() {
+    m_state += 0x9E3779B97F4A7C15ull;
+    uint64_t z = m_state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+size_t CorpusGenerator::nextBelow(size_t bound) {
+    return static_cast<size_t>(nextRandom() % bound);
+}
+
+bool CorpusGenerator::chance(double probability) {
+    // 53 random bits mapped to [0, 1)
+    return static_cast<double>(nextRandom() >> 11) * 0x1.0p-53 < probability;
+}
+
+void CorpusGenerator::indent(int level) {
+    m_out.append(static_cast<size_t>(level) * 4, ' ');
+}
+
+void CorpusGenerator::emitIdentifier() {
+    // A numeric suffix keeps every identifier clear of the keywords
+    if (chance(m_options.unicodeRatio)) {
+        m_out.append(kUnicodeStems[nextBelow(kUnicodeStems.size())]);
+    } else {
+        m_out.append(kAsciiStems[nextBelow(kAsciiStems.size())]);
+    }
+    m_out.push_back('_');
+    m_out.append(std::to_string(nextBelow(64)));
+}
+
+void CorpusGenerator::emitType() {
+    m_out.append(kTypes[nextBelow(kTypes.size())]);
+}
+
+void CorpusGenerator::emitInteger() {
+    switch (nextBelow(5)) {
+        case 0: m_out.append(std::to_string(nextBelow(1000))); break;
+        case 1: m_out.append(std::to_string(nextBelow(1000) + 1)).append("_000"); break;
+        case 2: m_out.append("0x").append(std::to_string(nextBelow(9) + 1)).append("F_FF"); break;
+        case 3: m_out.append("0b1010_").append(nextBelow(2) == 0 ? "0101" : "1100"); break;
+        case 4: m_out.append("0o").append(std::to_string(nextBelow(7) + 1)).append("55"); break;
+    }
+}
+
+void CorpusGenerator::emitFloat() {
+    m_out.append(std::to_string(nextBelow(100))).push_back('.');
+    m_out.append(std::to_string(nextBelow(1000)));
+    if (nextBelow(3) == 0) {
+        m_out.append(nextBelow(2) == 0 ? "e-" : "e").append(std::to_string(nextBelow(30) + 1));
+    }
+}
+
+void CorpusGenerator::emitString() {
+    const bool isUnicode = chance(m_options.unicodeRatio);
+    const size_t words = nextBelow(6) + 1;
+
+    m_out.push_back('"');
+    for (size_t i = 0; i < words; ++i) {
+        if (i > 0) {
+            m_out.push_back(' ');
+        }
+        if (isUnicode && nextBelow(2) == 0) {
+            m_out.append(kUnicodeWords[nextBelow(kUnicodeWords.size())]);
+        } else {
+            m_out.append(kAsciiWords[nextBelow(kAsciiWords.size())]);
+        }
+        if (nextBelow(4) == 0) {
+            m_out.append(kEscapes[nextBelow(kEscapes.size())]);
+        }
+    }
+    m_out.push_back('"');
+}
+
+void CorpusGenerator::emitChar() {
+    m_out.push_back('\'');
+    if (chance(m_options.unicodeRatio)) {
+        m_out.append(kUnicodeChars[nextBelow(kUnicodeChars.size())]);
+    } else {
+        m_out.append(kAsciiChars[nextBelow(kAsciiChars.size())]);
+    }
+    m_out.push_back('\'');
+}
+
+void CorpusGenerator::emitLiteral() {
+    const size_t total = m_options.integerWeight + m_options.floatWeight + m_options.stringWeight + m_options.charWeight;
+    if (total == 0) {
+        return emitInteger();
+    }
+
+    size_t pick = nextBelow(total);
+    if (pick < m_options.integerWeight) {
+        return emitInteger();
+    }
+    pick -= m_options.integerWeight;
+    if (pick < m_options.floatWeight) {
+        return emitFloat();
+    }
+    pick -= m_options.floatWeight;
+    if (pick < m_options.stringWeight) {
+        return emitString();
+    }
+    emitChar();
+}
+
+void CorpusGenerator::emitExpression(int depth) {
+    if (depth < MaxExpressionDepth && nextBelow(3) == 0) {
+        const bool isGrouped = nextBelow(2) == 0;
+        if (isGrouped) {
+            m_out.push_back('(');
+        }
+        emitExpression(depth + 1);
+        m_out.push_back(' ');
+        m_out.append(kBinaryOperators[nextBelow(kBinaryOperators.size())]);
+        m_out.push_back(' ');
+        emitExpression(depth + 1);
+        if (isGrouped) {
+            m_out.push_back(')');
+        }
+        return;
+    }
+
+    if (chance(m_options.identifierDensity)) {
+        emitIdentifier();
+        if (nextBelow(8) == 0) {
+            // Call with a couple of arguments
+            m_out.push_back('(');
+            emitExpression(MaxExpressionDepth);
+            m_out.append(", ");
+            emitExpression(MaxExpressionDepth);
+            m_out.push_back(')');
+        }
+    } else {
+        emitLiteral();
+    }
+}
+
+void CorpusGenerator::emitComment(int level) {
+    indent(level);
+    switch (nextBelow(3)) {
+        case 0:
+            m_out.append("// ").append(kAsciiWords[nextBelow(kAsciiWords.size())]).append(" the ");
+            emitIdentifier();
+            m_out.push_back('\n');
+            break;
+        case 1:
+            m_out.append("/// Returns the ");
+            emitIdentifier();
+            m_out.append(" of the current block\n");
+            break;
+        case 2: {
+            const size_t depth = nextBelow(m_options.commentNestingDepth + 1);
+            m_out.append("/* ");
+            for (size_t i = 0; i < depth; ++i) {
+                m_out.append("see /* ");
+            }
+            m_out.append(kAsciiWords[nextBelow(kAsciiWords.size())]);
+            for (size_t i = 0; i < depth; ++i) {
+                m_out.append(" */");
+            }
+            m_out.append(" */\n");
+            break;
+        }
+    }
+}
+
+void CorpusGenerator::emitStatement(int level, int depth) {
+    if (chance(m_options.commentRatio)) {
+        emitComment(level);
+    }
+
+    indent(level);
+    const size_t kind = depth < MaxStatementDepth ? nextBelow(8) : nextBelow(5);
+    switch (kind) {
+        case 0: case 1: case 2:
+            m_out.append("let ");
+            emitIdentifier();
+            m_out.append(": ");
+            emitType();
+            m_out.append(" = ");
+            emitExpression(0);
+            m_out.append(";\n");
+            break;
+        case 3: case 4:
+            emitIdentifier();
+            m_out.push_back(' ');
+            m_out.append(kAssignOperators[nextBelow(kAssignOperators.size())]);
+            m_out.push_back(' ');
+            emitExpression(0);
+            m_out.append(";\n");
+            break;
+        case 5: case 6: {
+            m_out.append(kind == 5 ? "if " : "while ");
+            emitExpression(0);
+            m_out.append(" {\n");
+            const size_t count = nextBelow(3) + 1;
+            for (size_t i = 0; i < count; ++i) {
+                emitStatement(level + 1, depth + 1);
+            }
+            indent(level);
+            m_out.append("}\n");
+            break;
+        }
+        case 7: {
+            m_out.append("for ");
+            emitIdentifier();
+            m_out.append(" in ");
+            emitExpression(MaxExpressionDepth);
+            m_out.append(" {\n");
+            emitStatement(level + 1, depth + 1);
+            indent(level);
+            m_out.append("}\n");
+            break;
+        }
+    }
+}
+
+void CorpusGenerator::emitFunction() {
+    if (chance(m_options.commentRatio)) {
+        emitComment(0);
+    }
+
+    m_out.append("fn ");
+    emitIdentifier();
+    m_out.push_back('(');
+    const size_t params = nextBelow(4);
+    for (size_t i = 0; i < params; ++i) {
+        if (i > 0) {
+            m_out.append(", ");
+        }
+        emitIdentifier();
+        m_out.append(": ");
+        emitType();
+    }
+    m_out.append(") -> ");
+    emitType();
+    m_out.append(" {\n");
+
+    const size_t statements = nextBelow(8) + 2;
+    for (size_t i = 0; i < statements; ++i) {
+        emitStatement(1, 0);
+    }
+
+    indent(1);
+    m_out.append("return ");
+    emitExpression(0);
+    m_out.append(";\n}\n\n");
+}
+
+void CorpusGenerator::emitHugeString() {
+    m_out.append("let blob_").append(std::to_string(m_nameCounter++)).append(": string = \"");
+    const size_t end = m_out.size() + m_options.hugeStringSize;
+    while (m_out.size() < end) {
+        m_out.append(kAsciiWords[nextBelow(kAsciiWords.size())]);
+        m_out.append(nextBelow(16) == 0 ? "\\n" : " ");
+    }
+    m_out.append("\";\n\n");
+}
+
+void CorpusGenerator::emitHugeComment() {
+    for (uint32_t i = 0; i < m_options.hugeCommentDepth; ++i) {
+        m_out.append("/* ");
+    }
+    m_out.append("deepest");
+    for (uint32_t i = 0; i < m_options.hugeCommentDepth; ++i) {
+        m_out.append(" */");
+    }
+    m_out.append("\n\n");
+}
+
+std::string CorpusGenerator::generate() {
+    m_out.clear();
+    m_out.reserve(m_options.size + m_options.hugeStringSize + m_options.hugeCommentDepth * 6 + 4096);
+    m_out.append("//! Synthetic corpus, seed ").append(std::to_string(m_options.seed)).append("\n\n");
+
+    bool hasPathological = m_options.hugeStringSize == 0 && m_options.hugeCommentDepth == 0;
+    while (m_out.size() < m_options.size || !hasPathological) {
+        if (!hasPathological && m_out.size() >= m_options.size / 2) {
+            if (m_options.hugeStringSize > 0) {
+                emitHugeString();
+            }
+            if (m_options.hugeCommentDepth > 0) {
+                emitHugeComment();
+            }
+            hasPathological = true;
+            continue;
+        }
+        emitFunction();
+    }
+
+    return std::move(m_out);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+/// Knobs for a synthetic Blaze source. Generation is fully determined by these values,
+/// the same options always produce byte-identical output on every platform.
+struct CorpusOptions {
+    uint64_t seed = 1;
+
+    // Approximate output size in bytes, generation stops after the function that crosses it
+    size_t size = 1 << 20;
+
+    // Probability that an expression operand is an identifier rather than a literal
+    double identifierDensity = 0.6;
+
+    // Probability that an identifier, string or char literal contains non-ASCII text
+    double unicodeRatio = 0.0;
+
+    // Relative weights of the literal kinds
+    uint32_t integerWeight = 4;
+    uint32_t floatWeight = 2;
+    uint32_t stringWeight = 2;
+    uint32_t charWeight = 1;
+
+    // Probability of a comment before a statement, and how deeply block comments nest
+    double commentRatio = 0.1;
+    uint32_t commentNestingDepth = 2;
+
+    // Pathological inputs, emitted once in the middle of the output when non-zero
+    size_t hugeStringSize = 0;
+    uint32_t hugeCommentDepth = 0;
+};
+
+class CorpusGenerator {
+public:
+    explicit CorpusGenerator(const CorpusOptions& options);
+
+    std::string generate();
+
+private:
+    CorpusOptions m_options;
+    uint64_t m_state;
+    std::string m_out;
+    size_t m_nameCounter = 0;
+
+    uint64_t nextRandom();
+    size_t nextBelow(size_t bound);
+    bool chance(double probability);
+
+    void indent(int level);
+    void emitIdentifier();
+    void emitType();
+    void emitInteger();
+    void emitFloat();
+    void emitString();
+    void emitChar();
+    void emitLiteral();
+    void emitExpression(int depth);
+    void emitComment(int level);
+    void emitStatement(int level, int depth);
+    void emitFunction();
+    void emitHugeString();
+    void emitHugeComment();
+};
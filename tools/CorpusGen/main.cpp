@@ -0,0 +1,103 @@
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#include "CorpusGenerator.hpp"
+
+namespace {
+    constexpr std::string_view kUsage =
+        "Usage: blaze_gen_corpus [options]\n"
+        "  -o, --output <file>           Write to a file instead of stdout\n"
+        "  --seed <n>                    Random seed (default 1)\n"
+        "  --size <bytes>                Approximate output size (default 1048576)\n"
+        "  --identifier-density <p>      Share of operands that are identifiers (default 0.6)\n"
+        "  --unicode-ratio <p>           Share of names and text that is non-ASCII (default 0)\n"
+        "  --literal-mix <i,f,s,c>       Weights of integer, float, string, char literals (default 4,2,2,1)\n"
+        "  --comment-ratio <p>           Probability of a comment before a statement (default 0.1)\n"
+        "  --comment-depth <n>           Maximum block comment nesting (default 2)\n"
+        "  --huge-string <bytes>         Emit one string literal of this size\n"
+        "  --huge-comment-depth <n>      Emit one block comment nested this deep\n";
+
+    void parseLiteralMix(std::string_view mix, CorpusOptions& options) {
+        uint32_t* weights[] = { &options.integerWeight, &options.floatWeight, &options.stringWeight, &options.charWeight };
+        for (uint32_t* weight : weights) {
+            const size_t comma = mix.find(',');
+            *weight = static_cast<uint32_t>(std::stoul(std::string(mix.substr(0, comma))));
+            if (comma == std::string_view::npos) {
+                return;
+            }
+            mix.remove_prefix(comma + 1);
+        }
+    }
+
+    std::optional<CorpusOptions> parseOptions(int argc, char** argv, std::string& outputPath) {
+        CorpusOptions options;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            if (i + 1 >= argc) {
+                return std::nullopt;
+            }
+            const std::string value = argv[++i];
+
+            if (arg == "-o" || arg == "--output") {
+                outputPath = value;
+            } else if (arg == "--seed") {
+                options.seed = std::stoull(value);
+            } else if (arg == "--size") {
+                options.size = std::stoull(value);
+            } else if (arg == "--identifier-density") {
+                options.identifierDensity = std::stod(value);
+            } else if (arg == "--unicode-ratio") {
+                options.unicodeRatio = std::stod(value);
+            } else if (arg == "--literal-mix") {
+                parseLiteralMix(value, options);
+            } else if (arg == "--comment-ratio") {
+                options.commentRatio = std::stod(value);
+            } else if (arg == "--comment-depth") {
+                options.commentNestingDepth = static_cast<uint32_t>(std::stoul(value));
+            } else if (arg == "--huge-string") {
+                options.hugeStringSize = std::stoull(value);
+            } else if (arg == "--huge-comment-depth") {
+                options.hugeCommentDepth = static_cast<uint32_t>(std::stoul(value));
+            } else {
+                return std::nullopt;
+            }
+        }
+
+        return options;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string outputPath;
+    std::optional<CorpusOptions> options;
+    try {
+        options = parseOptions(argc, argv, outputPath);
+    } catch (const std::logic_error&) {
+        options = std::nullopt;
+    }
+
+    if (!options.has_value()) {
+        std::cerr << kUsage;
+        return EXIT_FAILURE;
+    }
+
+    const std::string corpus = CorpusGenerator(options.value()).generate();
+
+    if (outputPath.empty()) {
+        std::cout << corpus;
+        return EXIT_SUCCESS;
+    }
+
+    std::ofstream file(outputPath, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open output file: " << outputPath << '\n';
+        return EXIT_FAILURE;
+    }
+    file << corpus;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,110 @@
+// Generates the XID_Start / XID_Continue lookup tables used by Utils/Unicode.hpp.
+//
+// Usage: blaze_gen_unicode_tables <output.inc>
+//
+// The tables are a three-stage trie over the codepoint:
+//   stage1[cp >> 12]                          -> block of stage2
+//   stage2[block * 64 + ((cp >> 6) & 63)]     -> leaf
+//   leaves[leaf]                              -> 64-bit start / continue bitmaps
+// Identical blocks and leaves are shared, which keeps the whole table small.
+
+#include <map>
+#include <array>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <utility>
+#include <unicode/uchar.h>
+#include <unicode/uversion.h>
+
+namespace {
+    constexpr uint32_t CodepointCount = 0x110000;
+    constexpr uint32_t LeafBits = 6;
+    constexpr uint32_t BlockBits = 12;
+    constexpr uint32_t LeavesPerBlock = 1u << (BlockBits - LeafBits);
+
+    using Leaf = std::pair<uint64_t, uint64_t>;
+    using Block = std::array<uint16_t, LeavesPerBlock>;
+
+    Leaf buildLeaf(uint32_t first) {
+        Leaf leaf = { 0, 0 };
+        for (uint32_t bit = 0; bit < (1u << LeafBits); ++bit) {
+            const UChar32 cp = static_cast<UChar32>(first + bit);
+            if (u_hasBinaryProperty(cp, UCHAR_XID_START)) {
+                leaf.first |= uint64_t(1) << bit;
+            }
+            if (u_hasBinaryProperty(cp, UCHAR_XID_CONTINUE)) {
+                leaf.second |= uint64_t(1) << bit;
+            }
+        }
+        return leaf;
+    }
+
+    template<typename T>
+    uint32_t intern(std::map<T, uint32_t>& index, std::vector<T>& storage, const T& value) {
+        auto [it, inserted] = index.emplace(value, static_cast<uint32_t>(storage.size()));
+        if (inserted) {
+            storage.push_back(value);
+        }
+        return it->second;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::fprintf(stderr, "Usage: blaze_gen_unicode_tables <output.inc>\n");
+        return 1;
+    }
+
+    std::map<Leaf, uint32_t> leafIndex;
+    std::vector<Leaf> leaves;
+    std::map<Block, uint32_t> blockIndex;
+    std::vector<Block> blocks;
+    std::vector<uint32_t> stage1;
+
+    for (uint32_t blockStart = 0; blockStart < CodepointCount; blockStart += 1u << BlockBits) {
+        Block block = {};
+        for (uint32_t i = 0; i < LeavesPerBlock; ++i) {
+            const uint32_t leaf = intern(leafIndex, leaves, buildLeaf(blockStart + (i << LeafBits)));
+            block[i] = static_cast<uint16_t>(leaf);
+        }
+        stage1.push_back(intern(blockIndex, blocks, block));
+    }
+
+    if (blocks.size() > UINT8_MAX || leaves.size() > UINT16_MAX) {
+        std::fprintf(stderr, "error: Unicode tables do not fit the index types\n");
+        return 1;
+    }
+
+    FILE* out = std::fopen(argv[1], "w");
+    if (out == nullptr) {
+        std::fprintf(stderr, "error: Could not open `%s`\n", argv[1]);
+        return 1;
+    }
+
+    std::fprintf(out, "// Generated by blaze_gen_unicode_tables from ICU %s (Unicode %s), do not edit.\n\n", U_ICU_VERSION, U_UNICODE_VERSION);
+
+    std::fprintf(out, "const uint8_t g_xidStage1[%zu] = {", stage1.size());
+    for (size_t i = 0; i < stage1.size(); ++i) {
+        std::fprintf(out, "%s%u,", i % 16 == 0 ? "\n    " : " ", stage1[i]);
+    }
+    std::fprintf(out, "\n};\n\n");
+
+    std::fprintf(out, "const uint16_t g_xidStage2[%zu] = {", blocks.size() * LeavesPerBlock);
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        for (size_t i = 0; i < LeavesPerBlock; ++i) {
+            std::fprintf(out, "%s%u,", i % 16 == 0 ? "\n    " : " ", blocks[b][i]);
+        }
+    }
+    std::fprintf(out, "\n};\n\n");
+
+    std::fprintf(out, "const XIDLeaf g_xidLeaves[%zu] = {\n", leaves.size());
+    for (const Leaf& leaf : leaves) {
+        std::fprintf(out, "    { 0x%016llxull, 0x%016llxull },\n",
+            static_cast<unsigned long long>(leaf.first), static_cast<unsigned long long>(leaf.second));
+    }
+    std::fprintf(out, "};\n");
+
+    std::fclose(out);
+    return 0;
+}